@@ -152,5 +152,17 @@ typedef struct {
 } DbgUiRectFilled;
 DECLARE_FUNC(void, dbgui_foreground_rect_filled, const DbgUiRectFilled *rect);
 
+// Only runs the enclosed UI code every interval ticks (or less often if it goes over the debug UI frame-time budget)
+// and otherwise reuses what it drew last time. dbgui_end_throttled must only be called if this returns true.
+DECLARE_FUNC(s32, dbgui_begin_throttled, const char *id, s32 interval);
+DECLARE_FUNC(void, dbgui_end_throttled);
+DECLARE_FUNC(void, dbgui_throttle_menu);
+
+// Controls and results of the input-to-photon latency measurement, drawn inside a tab item.
+DECLARE_FUNC(void, dbgui_latency_tab);
+
+// Texture packs loaded by the renderer and their load statistics, drawn inside a tab item.
+DECLARE_FUNC(void, dbgui_texture_packs_tab);
+
 void dbgui_textf(const char *fmt, ...);
 void dbgui_label_textf(const char *label, const char *fmt, ...);
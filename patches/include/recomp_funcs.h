@@ -5,6 +5,7 @@
 DECLARE_FUNC(void, recomp_puts, const char* data, u32 size);
 DECLARE_FUNC(void, recomp_eputs, const char* data, u32 size);
 DECLARE_FUNC(s32, recomp_get_diprintf_enabled);
+DECLARE_FUNC(void, recomp_reset_frame_arena);
 
 typedef enum {
     RECOMP_ASPECT_ORIGINAL,
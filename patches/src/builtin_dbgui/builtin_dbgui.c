@@ -22,26 +22,33 @@ void builtin_dbgui() {
             dbgui_menu_item("Character", &charCheatOpen);
             dbgui_end_menu();
         }
+        dbgui_throttle_menu();
         dbgui_end_main_menu_bar();
     }
 
-    if (dllsOpen) {
+    if (dllsOpen && dbgui_begin_throttled("DLLs", 1)) {
         dbgui_dlls_window(&dllsOpen);
+        dbgui_end_throttled();
     }
-    if (audioOpen) {
+    if (audioOpen && dbgui_begin_throttled("Audio", 1)) {
         dbgui_audio_window(&audioOpen);
+        dbgui_end_throttled();
     }
-    if (warpCheatOpen) {
+    if (warpCheatOpen && dbgui_begin_throttled("Warp", 1)) {
         dbgui_warp_cheat_window(&warpCheatOpen);
+        dbgui_end_throttled();
     }
-    if (charCheatOpen) {
+    if (charCheatOpen && dbgui_begin_throttled("Character", 1)) {
         dbgui_character_cheat_window(&charCheatOpen);
+        dbgui_end_throttled();
     }
-    if (graphicsOpen) {
+    if (graphicsOpen && dbgui_begin_throttled("Graphics", 1)) {
         dbgui_graphics_window(&graphicsOpen);
+        dbgui_end_throttled();
     }
-    if (memoryOpen) {
+    if (memoryOpen && dbgui_begin_throttled("Memory", 1)) {
         dbgui_memory_window(&memoryOpen);
+        dbgui_end_throttled();
     }
 }
 
@@ -264,6 +264,16 @@ void dbgui_graphics_window(s32 *open) {
                 recomp_tab();
                 dbgui_end_tab_item();
             }
+
+            if (dbgui_begin_tab_item("Latency", NULL)) {
+                dbgui_latency_tab();
+                dbgui_end_tab_item();
+            }
+
+            if (dbgui_begin_tab_item("Texture Packs", NULL)) {
+                dbgui_texture_packs_tab();
+                dbgui_end_tab_item();
+            }
             
             dbgui_end_tab_bar();
         }
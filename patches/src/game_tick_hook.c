@@ -1,4 +1,5 @@
 #include "patches.h"
+#include "recomp_funcs.h"
 #include "dbgui.h"
 #include "builtin_dbgui.h"
 #include "ui_funcs.h"
@@ -23,6 +24,9 @@ void game_tick_hook() {
 
 void game_tick_end_hook() {
     recomp_on_game_tick_end();
+
+    // Release native-side temporaries allocated during this tick.
+    recomp_reset_frame_arena();
 }
 
 static void dbgui() {
@@ -30,6 +34,7 @@ static void dbgui() {
     
     if (dbgui_is_open()) {
         builtin_dbgui();
+        // Not throttled, since mods may rely on their callback running every tick.
         recomp_on_dbgui();
 
         if (dbgui_begin_main_menu_bar()) {
@@ -1,5 +1,9 @@
 #include "backend.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 #ifdef _WIN32
 #include <SDL_video.h>
 #else
@@ -56,16 +60,88 @@ struct VulkanContext {
 
 // We must use our own ImGui context to avoid conflicting with the RT64 inspector where possible
 ImGuiContext *dino_imgui_ctx;
-bool b_is_open = false;
+std::atomic_bool b_is_open = false;
 bool b_in_ui_frame = false;
+CommandStream record_stream;
+FrameResults frame_results;
+bool frame_results_fresh = false;
 
-static ImGuiContext *prev_ctx;
 static std::unique_ptr<RT64::RenderDescriptorSet> descriptor_set;
-static std::mutex frame_mutex;
+// ImGui's current context is a process-wide global and contexts aren't thread safe. The render backends read
+// their state through the current context, so submitting a snapshot needs ours to be current too. The debug UI
+// thread holds this for as long as it builds a frame and the render thread holds it while submitting one.
+static std::mutex context_mutex;
 static moodycamel::ConcurrentQueue<SDL_Event> event_queue{};
-static moodycamel::LightweightSemaphore ui_frame_signal;
 static std::unique_ptr<VulkanContext> vulkanContext;
 
+// ImGui runs on its own thread. The game thread only records commands and hands them off here.
+static std::thread ui_thread;
+static std::atomic_bool ui_thread_running = false;
+static moodycamel::LightweightSemaphore ui_thread_signal;
+static std::mutex handoff_mutex;
+static CommandStream pending_stream;
+static bool b_frame_pending = false;
+static FrameResults published_results;
+static bool b_published_results_fresh = false;
+
+// A copy of a frame's ImDrawData that owns its draw lists, so the render thread can draw it while the
+// debug UI thread is already building the next frame.
+struct DrawDataSnapshot {
+    ImDrawData draw_data;
+    ImVector<ImDrawList*> lists;
+
+    ~DrawDataSnapshot() {
+        for (ImDrawList *list : lists) {
+            IM_DELETE(list);
+        }
+    }
+
+    template <typename T>
+    static void copy_vector(ImVector<T> &dst, const ImVector<T> &src) {
+        // ImVector's assignment operator frees the old storage, resize keeps it around between frames.
+        dst.resize(src.Size);
+        if (src.Size > 0) {
+            memcpy(dst.Data, src.Data, src.size_in_bytes());
+        }
+    }
+
+    void copy_from(const ImDrawData *src) {
+        while (lists.Size < src->CmdListsCount) {
+            lists.push_back(IM_NEW(ImDrawList)(nullptr));
+        }
+
+        draw_data.Valid = src->Valid;
+        draw_data.CmdListsCount = src->CmdListsCount;
+        draw_data.TotalIdxCount = src->TotalIdxCount;
+        draw_data.TotalVtxCount = src->TotalVtxCount;
+        draw_data.DisplayPos = src->DisplayPos;
+        draw_data.DisplaySize = src->DisplaySize;
+        draw_data.FramebufferScale = src->FramebufferScale;
+        draw_data.OwnerViewport = src->OwnerViewport;
+        draw_data.CmdLists.resize(src->CmdListsCount);
+
+        for (int i = 0; i < src->CmdListsCount; i++) {
+            const ImDrawList *src_list = src->CmdLists[i];
+            ImDrawList *dst_list = lists[i];
+            copy_vector(dst_list->CmdBuffer, src_list->CmdBuffer);
+            copy_vector(dst_list->IdxBuffer, src_list->IdxBuffer);
+            copy_vector(dst_list->VtxBuffer, src_list->VtxBuffer);
+            dst_list->Flags = src_list->Flags;
+            draw_data.CmdLists[i] = dst_list;
+        }
+    }
+};
+
+// Triple buffered handoff of finished frames. The debug UI thread fills the back snapshot and swaps it
+// with the ready one, the render thread swaps the ready one with its front snapshot when a new frame is
+// available and otherwise keeps drawing the last one. Neither side ever waits on the other.
+static DrawDataSnapshot draw_snapshots[3];
+static constexpr uint8_t snapshot_index_mask = 0x3;
+static constexpr uint8_t snapshot_new_bit = 0x4;
+static uint8_t back_snapshot = 0;
+static std::atomic_uint8_t ready_snapshot = 1;
+static uint8_t front_snapshot = 2;
+
 static RT64::UserConfiguration::GraphicsAPI get_graphics_api() {
     const ultramodern::renderer::GraphicsConfig &config = ultramodern::renderer::get_graphics_config();
 
@@ -92,7 +168,7 @@ static RT64::UserConfiguration::GraphicsAPI get_graphics_api() {
     }
 }
 
-void begin() {
+static void process_events() {
     if (!b_is_open) {
         // Still process the event queue but don't send any to ImGui
         SDL_Event event{};
@@ -108,13 +184,6 @@ void begin() {
         }
     }
 
-    b_in_ui_frame = true;
-
-    frame_mutex.lock();
-
-    prev_ctx = ImGui::GetCurrentContext();
-    ImGui::SetCurrentContext(dino_imgui_ctx);
-
     SDL_Event event{};
     while (event_queue.try_dequeue(event)) {
         if (event.type == SDL_KEYDOWN && 
@@ -126,6 +195,16 @@ void begin() {
 
         ImGui_ImplSDL2_ProcessEvent(&event);
     }
+}
+
+// Runs on the debug UI thread.
+static void run_ui_frame(const CommandStream &stream, FrameResults &results) {
+    context_mutex.lock();
+
+    ImGuiContext *prev_ctx = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(dino_imgui_ctx);
+
+    process_events();
     
     ImGui_ImplSDL2_NewFrame();
 
@@ -135,6 +214,8 @@ void begin() {
             ImGui_ImplDX12_NewFrame();
 #else
             assert(false && "Unsupported Graphics API.");
+            ImGui::SetCurrentContext(prev_ctx);
+            context_mutex.unlock();
             return;
 #endif
             break;
@@ -149,18 +230,83 @@ void begin() {
     }
 
     ImGui::NewFrame();
+
+    results.clear();
+    replay_commands(stream, results);
+    results.display_size = ImGui::GetIO().DisplaySize;
+
+    ImGui::Render();
+    ImDrawData *draw_data = ImGui::GetDrawData();
+    ImGui::SetCurrentContext(prev_ctx);
+
+    context_mutex.unlock();
+
+    // The draw data is only modified by this thread, so it's copied without holding up the render thread.
+    draw_snapshots[back_snapshot].copy_from(draw_data);
+
+    back_snapshot = ready_snapshot.exchange(back_snapshot | snapshot_new_bit) & snapshot_index_mask;
+}
+
+static void ui_thread_func() {
+    CommandStream stream;
+    FrameResults results;
+
+    while (true) {
+        ui_thread_signal.wait();
+        if (!ui_thread_running) {
+            break;
+        }
+
+        {
+            const std::lock_guard<std::mutex> lock(handoff_mutex);
+            if (!b_frame_pending) {
+                continue;
+            }
+            std::swap(stream, pending_stream);
+            b_frame_pending = false;
+        }
+
+        run_ui_frame(stream, results);
+
+        {
+            const std::lock_guard<std::mutex> lock(handoff_mutex);
+            if (b_published_results_fresh) {
+                // The game thread skipped the previous results, don't drop any clicks from them.
+                results.merge_unconsumed(published_results);
+            }
+            std::swap(results, published_results);
+            b_published_results_fresh = true;
+        }
+    }
+}
+
+void begin() {
+    b_in_ui_frame = true;
+
+    record_stream.clear();
+
+    const std::lock_guard<std::mutex> lock(handoff_mutex);
+    frame_results_fresh = b_published_results_fresh;
+    if (b_published_results_fresh) {
+        std::swap(frame_results, published_results);
+        b_published_results_fresh = false;
+    }
 }
 
 void end() {
     if (!b_is_open && !b_in_ui_frame) return;
-    
-    ImGui::Render();
-    ImGui::SetCurrentContext(prev_ctx);
 
-    frame_mutex.unlock();
+    record_stream.finish_command();
+
+    {
+        // If the debug UI thread hasn't picked up the previous frame yet, it's replaced by this one.
+        const std::lock_guard<std::mutex> lock(handoff_mutex);
+        std::swap(record_stream, pending_stream);
+        b_frame_pending = true;
+    }
 
-    if (ui_frame_signal.availableApprox() == 0) {
-        ui_frame_signal.signal();
+    if (ui_thread_signal.availableApprox() == 0) {
+        ui_thread_signal.signal();
     }
 
     b_in_ui_frame = false;
@@ -267,6 +413,9 @@ static void rt64_init_hook(RT64::RenderInterface* _interface, RT64::RenderDevice
     SDL_AddEventWatch(sdl_event_filter, nullptr);
 
     ImGui::SetCurrentContext(prev_ctx);
+
+    ui_thread_running = true;
+    ui_thread = std::thread(ui_thread_func);
 }
 
 static void rt64_draw_hook(RT64::RenderCommandList* command_list, RT64::RenderFramebuffer* swap_chain_framebuffer) {
@@ -275,19 +424,18 @@ static void rt64_draw_hook(RT64::RenderCommandList* command_list, RT64::RenderFr
     }
 
     if (!b_is_open) return;
-    
-    // TODO: With higher framerate settings, sometimes we end up deadlocked here. This timeout of 1/30th of a second
-    // prevents the game from getting locked up while also working as intended on the default framerate option, but
-    // shouldn't be necessary and be fixed at some point.
-    ui_frame_signal.wait((int64_t)((1.0 / 30.0) * 1000000));
-    
-    const std::lock_guard<std::mutex> frame_lock(frame_mutex);
+
+    if ((ready_snapshot.load() & snapshot_new_bit) != 0) {
+        front_snapshot = ready_snapshot.exchange(front_snapshot) & snapshot_index_mask;
+    }
+
+    const std::lock_guard<std::mutex> context_lock(context_mutex);
 
     ImGuiContext *prev_ctx = ImGui::GetCurrentContext();
     ImGui::SetCurrentContext(dino_imgui_ctx);
 
-    ImDrawData *draw_data = ImGui::GetDrawData();
-    if (draw_data != nullptr) {
+    ImDrawData *draw_data = &draw_snapshots[front_snapshot].draw_data;
+    if (draw_data->Valid) {
         switch (get_graphics_api()) {
             case RT64::UserConfiguration::GraphicsAPI::D3D12: {
 #ifdef _WIN32
@@ -314,6 +462,12 @@ static void rt64_draw_hook(RT64::RenderCommandList* command_list, RT64::RenderFr
 }
 
 static void rt64_deinit_hook() {
+    ui_thread_running = false;
+    ui_thread_signal.signal();
+    if (ui_thread.joinable()) {
+        ui_thread.join();
+    }
+
     ImGuiContext *prev_ctx = ImGui::GetCurrentContext();
     ImGui::SetCurrentContext(dino_imgui_ctx);
 
@@ -1,12 +1,22 @@
 #pragma once
 
+#include <atomic>
+
 #include "imgui.h"
 
+#include "commands.hpp"
+
 namespace dino::debug_ui::backend {
 
 extern ImGuiContext *dino_imgui_ctx;
-extern bool b_is_open;
+extern std::atomic_bool b_is_open;
 extern bool b_in_ui_frame;
+// Commands recorded by the game thread for the current frame.
+extern CommandStream record_stream;
+// Results of the most recently replayed frame. Only accessed by the game thread.
+extern FrameResults frame_results;
+// Whether frame_results were produced since the last frame. One-shot results are ignored otherwise.
+extern bool frame_results_fresh;
 
 void begin();
 void end();
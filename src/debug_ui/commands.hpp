@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "imgui.h"
+
+namespace dino::debug_ui {
+
+// Debug UI calls made on the game thread are recorded into a command stream and replayed into ImGui
+// on the debug UI thread. Anything ImGui would return (button presses, edited values, whether a window
+// is expanded, etc.) is reported back as a WidgetResult and seen by the game thread on the next frame.
+
+enum class CommandType : uint8_t {
+    Begin,
+    End,
+    Text,
+    LabelText,
+    SameLine,
+    NewLine,
+    Separator,
+    BeginCombo,
+    EndCombo,
+    Selectable,
+    Button,
+    BeginMainMenuBar,
+    EndMainMenuBar,
+    BeginMenu,
+    EndMenu,
+    MenuItem,
+    CollapsingHeader,
+    TreeNode,
+    TreePop,
+    BeginChild,
+    EndChild,
+    Checkbox,
+    InputInt,
+    InputFloat,
+    InputText,
+    SetNextItemWidth,
+    PushItemWidth,
+    PopItemWidth,
+    BeginTabBar,
+    EndTabBar,
+    BeginTabItem,
+    EndTabItem,
+    PushStrId,
+    PopId,
+    ForegroundText,
+    ForegroundLine,
+    ForegroundCircle,
+    ForegroundCircleFilled,
+    ForegroundEllipse,
+    ForegroundEllipseFilled,
+    ForegroundRect,
+    ForegroundRectFilled,
+};
+
+enum CommandFlags : uint8_t {
+    // The game thread predicted this scope as open, so its contents and closing command were recorded.
+    COMMAND_FLAG_PREDICTED_OPEN = 1 << 0,
+    // The widget was given a bool pointer (close button, menu item selection, etc.).
+    COMMAND_FLAG_HAS_BOOL = 1 << 1,
+    // Value of that bool pointer at record time.
+    COMMAND_FLAG_BOOL_VALUE = 1 << 2,
+};
+
+struct CommandHeader {
+    CommandType type;
+    uint8_t flags;
+    uint16_t padding;
+    // Total size of the command in bytes, including this header.
+    uint32_t size;
+};
+
+class CommandStream {
+public:
+    void clear() { data.clear(); }
+    bool empty() const { return data.empty(); }
+    size_t size() const { return data.size(); }
+    const uint8_t *begin() const { return data.data(); }
+    const uint8_t *end() const { return data.data() + data.size(); }
+
+    // Starts a new command. Payload fields are appended with write/write_str until the next begin_command.
+    void begin_command(CommandType type, uint8_t flags = 0) {
+        finish_command();
+        cur_command = data.size();
+        write(CommandHeader{ .type = type, .flags = flags, .padding = 0, .size = 0 });
+    }
+
+    // Patches the size of the command currently being recorded. Must be called before the stream is submitted.
+    void finish_command() {
+        if (cur_command != no_command) {
+            uint32_t size = (uint32_t)(data.size() - cur_command);
+            memcpy(data.data() + cur_command + offsetof(CommandHeader, size), &size, sizeof(size));
+            cur_command = no_command;
+        }
+    }
+
+    template <typename T>
+    void write(const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        size_t offset = data.size();
+        data.resize(offset + sizeof(T));
+        memcpy(data.data() + offset, &value, sizeof(T));
+    }
+
+    // Writes a length-prefixed, null-terminated copy of str. Null strings are preserved.
+    void write_str(const char *str) {
+        if (str == nullptr) {
+            write<uint32_t>(0);
+            return;
+        }
+
+        write_str(str, strlen(str));
+    }
+
+    void write_str(const char *str, size_t len) {
+        write<uint32_t>((uint32_t)len + 1);
+        size_t offset = data.size();
+        data.resize(offset + len + 1);
+        memcpy(data.data() + offset, str, len);
+        data[offset + len] = '\0';
+    }
+    // Copies the already recorded commands from offset start onward into out.
+    void copy_commands(size_t start, std::vector<uint8_t> &out) {
+        finish_command();
+        out.assign(data.begin() + start, data.end());
+    }
+
+    // Appends commands previously taken out with copy_commands.
+    void append_commands(const std::vector<uint8_t> &commands) {
+        finish_command();
+        data.insert(data.end(), commands.begin(), commands.end());
+    }
+private:
+    static constexpr size_t no_command = SIZE_MAX;
+    std::vector<uint8_t> data;
+    size_t cur_command = no_command;
+};
+
+// Reads the payload of a single command.
+class CommandReader {
+public:
+    CommandReader(const uint8_t *payload) : cur(payload) {}
+
+    template <typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        memcpy(&value, cur, sizeof(T));
+        cur += sizeof(T);
+        return value;
+    }
+
+    // Returns a pointer into the stream, or nullptr if a null string was written.
+    const char *read_str() {
+        uint32_t size = read<uint32_t>();
+        if (size == 0) {
+            return nullptr;
+        }
+
+        const char *str = reinterpret_cast<const char*>(cur);
+        cur += size;
+        return str;
+    }
+private:
+    const uint8_t *cur;
+};
+
+enum WidgetResultFlags : uint8_t {
+    // The widget was pressed or its value was edited. Only reported once.
+    RESULT_ACTIVATED = 1 << 0,
+    // Return value of Begin*, TreeNode and CollapsingHeader.
+    RESULT_EXPANDED = 1 << 1,
+    // The close button of a window or tab was clicked. Only reported once.
+    RESULT_CLOSED = 1 << 2,
+    RESULT_HOVERED = 1 << 3,
+    // New value of the widget's bool (checkbox, menu item selection).
+    RESULT_BOOL_VALUE = 1 << 4,
+};
+
+constexpr uint8_t one_shot_result_flags = RESULT_ACTIVATED | RESULT_CLOSED;
+
+struct WidgetResult {
+    uint8_t flags = 0;
+    int32_t int_value = 0;
+    float float_value = 0.0f;
+};
+
+struct FrameResults {
+    std::unordered_map<uint32_t, WidgetResult> widgets;
+    // Edited contents of input text widgets.
+    std::unordered_map<uint32_t, std::string> texts;
+    ImVec2 display_size{};
+    // Whether any widget has a one-shot result.
+    bool has_one_shot_results = false;
+
+    void clear() {
+        widgets.clear();
+        texts.clear();
+        has_one_shot_results = false;
+    }
+
+    // Carries over one-shot results from an older frame that was never seen by the game thread.
+    void merge_unconsumed(const FrameResults &older);
+};
+
+// Replays a recorded frame into the current ImGui context. Must be called between ImGui::NewFrame and ImGui::Render.
+void replay_commands(const CommandStream &stream, FrameResults &results);
+
+}
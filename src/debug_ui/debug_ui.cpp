@@ -1,11 +1,115 @@
 #include "debug_ui.hpp"
 #include "backend.hpp"
+#include "commands.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "imgui/imgui.h"
 #include "imgui/imgui_internal.h"
 
 namespace dino::debug_ui {
 
+// The debug UI thread replays commands recorded here and reports back results keyed by a hash of each
+// widget's label and the scopes it's in, similar to ImGui's ID stack.
+static std::vector<uint32_t> id_stack{ 0 };
+static uint32_t last_item_key = 0;
+static uint32_t unlabeled_item_count = 0;
+
+static uint32_t hash_bytes(uint32_t seed, const void *data, size_t size) {
+    // FNV-1a
+    uint32_t hash = seed ^ 2166136261U;
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+static uint32_t hash_str(uint32_t seed, const char *str) {
+    return hash_bytes(seed, str, strlen(str));
+}
+
+static uint32_t item_key(const char *label) {
+    // Like ImGui, only hash what comes after ### so the visible part of the label can change.
+    const char *id = strstr(label, "###");
+    last_item_key = hash_str(id_stack.back(), id != nullptr ? id : label);
+    return last_item_key;
+}
+
+// For items like text whose contents change from frame to frame.
+static uint32_t unlabeled_item_key() {
+    uint32_t index = unlabeled_item_count++;
+    last_item_key = hash_bytes(id_stack.back(), &index, sizeof(index));
+    return last_item_key;
+}
+
+static void push_scope(uint32_t key) {
+    id_stack.push_back(key);
+}
+
+static void pop_scope() {
+    if (id_stack.size() > 1) {
+        id_stack.pop_back();
+    }
+}
+
+static const WidgetResult *find_result(uint32_t key) {
+    auto it = backend::frame_results.widgets.find(key);
+    if (it == backend::frame_results.widgets.end()) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+static bool has_result_flag(uint32_t key, uint8_t flag, bool default_value) {
+    if ((flag & one_shot_result_flags) != 0 && !backend::frame_results_fresh) {
+        // Already seen last frame.
+        return false;
+    }
+
+    const WidgetResult *result = find_result(key);
+    if (result == nullptr) {
+        return default_value;
+    }
+    return (result->flags & flag) != 0;
+}
+
+static bool was_activated(uint32_t key) {
+    return has_result_flag(key, RESULT_ACTIVATED, false);
+}
+
+static bool was_closed(uint32_t key) {
+    return has_result_flag(key, RESULT_CLOSED, false);
+}
+
+static bool is_expanded(uint32_t key, bool default_expanded) {
+    return has_result_flag(key, RESULT_EXPANDED, default_expanded);
+}
+
+static CommandStream &stream() {
+    return backend::record_stream;
+}
+
+static uint8_t predicted_flags(bool predicted_open) {
+    return predicted_open ? COMMAND_FLAG_PREDICTED_OPEN : 0;
+}
+
+static uint8_t bool_flags(const bool *value) {
+    if (value == nullptr) {
+        return 0;
+    }
+    return COMMAND_FLAG_HAS_BOOL | (*value ? COMMAND_FLAG_BOOL_VALUE : 0);
+}
+
 bool is_open() {
     return backend::b_is_open;
 }
@@ -23,8 +127,44 @@ bool want_capture_keyboard() {
     return backend::b_is_open && backend::dino_imgui_ctx->IO.WantCaptureKeyboard;
 }
 
+// Throttled regions only re-run the code that records them every few frames and otherwise reuse the commands
+// recorded last time.
+struct ThrottledRegion {
+    std::vector<uint8_t> commands;
+    uint32_t unlabeled_item_count = 0;
+    bool has_commands = false;
+    // Interval requested by the caller and the one set in the menu, 0 if not overridden.
+    int requested_interval = 1;
+    int user_interval = 0;
+    int interval = 1;
+    uint32_t frames_since_update = 0;
+    uint64_t last_frame = 0;
+    // Moving average of how long an update takes.
+    float avg_cost_ms = 0.0f;
+};
+
+using ThrottleClock = std::chrono::steady_clock;
+
+static constexpr int max_throttled_interval = 30;
+
+static std::map<std::string, ThrottledRegion> throttled_regions;
+static ThrottledRegion *cur_region = nullptr;
+static size_t cur_region_start = 0;
+static uint32_t cur_region_unlabeled_start = 0;
+static ThrottleClock::time_point cur_region_start_time;
+static uint64_t frame_count = 0;
+static bool b_auto_throttle = true;
+// Amortized time per frame that a single region may take before it's throttled.
+static float region_budget_ms = 0.5f;
+
 void ui_frame_begin() {
     backend::begin();
+
+    id_stack.resize(1);
+    last_item_key = 0;
+    unlabeled_item_count = 0;
+    cur_region = nullptr;
+    frame_count++;
 }
 
 void ui_frame_end() {
@@ -40,197 +180,390 @@ static void assert_is_open() {
 
 bool begin(const char *name, bool *open) {
     assert_is_open();
-    return ImGui::Begin(name, open);
+    // Windows aren't affected by the ID stack.
+    uint32_t key = hash_str(0, name);
+
+    bool expanded = is_expanded(key, true);
+    if (open != nullptr && was_closed(key)) {
+        *open = false;
+        expanded = false;
+    }
+
+    stream().begin_command(CommandType::Begin, predicted_flags(expanded) | bool_flags(open));
+    stream().write(key);
+    stream().write_str(name);
+    push_scope(key);
+
+    return expanded;
 }
 
 void end() {
     assert_is_open();
-    ImGui::End();
+    stream().begin_command(CommandType::End);
+    pop_scope();
 }
 
 void text(const char *text) {
     assert_is_open();
-    ImGui::Text("%s", text);
+    stream().begin_command(CommandType::Text);
+    stream().write(unlabeled_item_key());
+    stream().write_str(text);
 }
 
 void label_text(const char *label, const char *text) {
     assert_is_open();
-    ImGui::LabelText(label, "%s", text);
+    stream().begin_command(CommandType::LabelText);
+    stream().write(item_key(label));
+    stream().write_str(label);
+    stream().write_str(text);
 }
 
 void same_line() {
     assert_is_open();
-    ImGui::SameLine();
+    stream().begin_command(CommandType::SameLine);
 }
 
 void new_line() {
     assert_is_open();
-    ImGui::NewLine();
+    stream().begin_command(CommandType::NewLine);
 }
 
 void separator() {
     assert_is_open();
-    ImGui::Separator();
+    stream().begin_command(CommandType::Separator);
 }
 
 bool begin_combo(const char *label, const char *preview) {
     assert_is_open();
-    return ImGui::BeginCombo(label, preview);
+    uint32_t key = item_key(label);
+    bool open = is_expanded(key, false);
+
+    stream().begin_command(CommandType::BeginCombo, predicted_flags(open));
+    stream().write(key);
+    stream().write_str(label);
+    stream().write_str(preview);
+    if (open) {
+        push_scope(key);
+    }
+
+    return open;
 }
 
 void end_combo() {
     assert_is_open();
-    ImGui::EndCombo();
+    stream().begin_command(CommandType::EndCombo);
+    pop_scope();
 }
 
 bool selectable(const char *label, bool *selected) {
     assert_is_open();
-    return ImGui::Selectable(label, selected);
+    uint32_t key = item_key(label);
+
+    stream().begin_command(CommandType::Selectable, bool_flags(selected));
+    stream().write(key);
+    stream().write_str(label);
+
+    return was_activated(key);
 }
 
 bool button(const char *label) {
     assert_is_open();
-    return ImGui::Button(label);
+    uint32_t key = item_key(label);
+
+    stream().begin_command(CommandType::Button);
+    stream().write(key);
+    stream().write_str(label);
+
+    return was_activated(key);
 }
 
 bool begin_main_menu_bar() {
     assert_is_open();
-    return ImGui::BeginMainMenuBar();
+    uint32_t key = hash_str(0, "##MainMenuBar");
+    bool open = is_expanded(key, true);
+
+    stream().begin_command(CommandType::BeginMainMenuBar, predicted_flags(open));
+    stream().write(key);
+    if (open) {
+        push_scope(key);
+    }
+
+    return open;
 }
 
 void end_main_menu_bar() {
     assert_is_open();
-    ImGui::EndMainMenuBar();
+    stream().begin_command(CommandType::EndMainMenuBar);
+    pop_scope();
 }
 
 bool begin_menu(const char *label) {
     assert_is_open();
-    return ImGui::BeginMenu(label);
+    uint32_t key = item_key(label);
+    bool open = is_expanded(key, false);
+
+    stream().begin_command(CommandType::BeginMenu, predicted_flags(open));
+    stream().write(key);
+    stream().write_str(label);
+    if (open) {
+        push_scope(key);
+    }
+
+    return open;
 }
 
 void end_menu() {
     assert_is_open();
-    ImGui::EndMenu();
+    stream().begin_command(CommandType::EndMenu);
+    pop_scope();
 }
 
 bool menu_item(const char *label, bool *selected) {
     assert_is_open();
-    return ImGui::MenuItem(label, NULL, selected);
+    uint32_t key = item_key(label);
+
+    bool pressed = was_activated(key);
+    if (pressed && selected != nullptr) {
+        *selected = has_result_flag(key, RESULT_BOOL_VALUE, *selected);
+    }
+
+    stream().begin_command(CommandType::MenuItem, bool_flags(selected));
+    stream().write(key);
+    stream().write_str(label);
+
+    return pressed;
 }
 
 bool collapsing_header(const char *label) {
     assert_is_open();
-    return ImGui::CollapsingHeader(label);
+    uint32_t key = item_key(label);
+
+    stream().begin_command(CommandType::CollapsingHeader);
+    stream().write(key);
+    stream().write_str(label);
+
+    return is_expanded(key, false);
 }
 
 bool tree_node(const char *label) {
     assert_is_open();
-    return ImGui::TreeNode(label);
+    uint32_t key = item_key(label);
+    bool open = is_expanded(key, false);
+
+    stream().begin_command(CommandType::TreeNode, predicted_flags(open));
+    stream().write(key);
+    stream().write_str(label);
+    if (open) {
+        push_scope(key);
+    }
+
+    return open;
 }
 
 void tree_pop() {
     assert_is_open();
-    ImGui::TreePop();
+    stream().begin_command(CommandType::TreePop);
+    pop_scope();
 }
 
 bool begin_child(const char *str_id) {
     assert_is_open();
-    return ImGui::BeginChild(str_id);
+    uint32_t key = item_key(str_id);
+    bool open = is_expanded(key, true);
+
+    stream().begin_command(CommandType::BeginChild, predicted_flags(open));
+    stream().write(key);
+    stream().write_str(str_id);
+    push_scope(key);
+
+    return open;
 }
 
 void end_child() {
     assert_is_open();
-    ImGui::EndChild();
+    stream().begin_command(CommandType::EndChild);
+    pop_scope();
 }
 
 bool checkbox(const char *label, bool *v) {
     assert_is_open();
-    return ImGui::Checkbox(label, v);
+    uint32_t key = item_key(label);
+
+    bool pressed = was_activated(key);
+    if (pressed) {
+        *v = has_result_flag(key, RESULT_BOOL_VALUE, *v);
+    }
+
+    stream().begin_command(CommandType::Checkbox, bool_flags(v));
+    stream().write(key);
+    stream().write_str(label);
+
+    return pressed;
 }
 
 bool input_int(const char *label, int *v) {
-    assert_is_open();
-    return ImGui::InputInt(label, v);
+    return input_int_ext(label, v, 1, 100, 0);
 }
 
 bool input_int_ext(const char *label, int *v, int step, int step_fast, ImGuiInputTextFlags flags) {
     assert_is_open();
-    return ImGui::InputInt(label, v, step, step_fast, flags);
+    uint32_t key = item_key(label);
+
+    bool changed = was_activated(key);
+    if (changed) {
+        *v = find_result(key)->int_value;
+    }
+
+    stream().begin_command(CommandType::InputInt);
+    stream().write(key);
+    stream().write<int32_t>(*v);
+    stream().write<int32_t>(step);
+    stream().write<int32_t>(step_fast);
+    stream().write<int32_t>(flags);
+    stream().write_str(label);
+
+    return changed;
 }
 
 bool input_float(const char *label, float *v) {
-    assert_is_open();
-    return ImGui::InputFloat(label, v);
+    return input_float_ext(label, v, 0.0f, 0.0f, "%.3f", 0);
 }
 
 bool input_float_ext(const char *label, float *v, float step, float step_fast, const char *format, ImGuiInputTextFlags flags) {
     assert_is_open();
-    return ImGui::InputFloat(label, v, step, step_fast, format, flags);
+    uint32_t key = item_key(label);
+
+    bool changed = was_activated(key);
+    if (changed) {
+        *v = find_result(key)->float_value;
+    }
+
+    stream().begin_command(CommandType::InputFloat);
+    stream().write(key);
+    stream().write(*v);
+    stream().write(step);
+    stream().write(step_fast);
+    stream().write<int32_t>(flags);
+    stream().write_str(label);
+    stream().write_str(format);
+
+    return changed;
 }
 
 bool input_text(const char *label, char *buf, size_t buf_size) {
-    assert_is_open();
-    return ImGui::InputText(label, buf, buf_size);
+    return input_text_ext(label, buf, buf_size, 0);
 }
 
 bool input_text_ext(const char *label, char *buf, size_t buf_size, ImGuiInputTextFlags flags) {
     assert_is_open();
-    return ImGui::InputText(label, buf, buf_size, flags);
+    uint32_t key = item_key(label);
+
+    bool changed = false;
+    if (was_activated(key) && buf_size > 0) {
+        auto it = backend::frame_results.texts.find(key);
+        if (it != backend::frame_results.texts.end()) {
+            size_t len = std::min(it->second.size(), buf_size - 1);
+            memcpy(buf, it->second.data(), len);
+            buf[len] = '\0';
+            changed = true;
+        }
+    }
+
+    stream().begin_command(CommandType::InputText);
+    stream().write(key);
+    stream().write<uint32_t>((uint32_t)buf_size);
+    stream().write<int32_t>(flags);
+    stream().write_str(label);
+    stream().write_str(buf, strnlen(buf, buf_size));
+
+    return changed;
 }
 
 void set_next_item_width(float width) {
     assert_is_open();
-    ImGui::SetNextItemWidth(width);
+    stream().begin_command(CommandType::SetNextItemWidth);
+    stream().write(width);
 }
 
 void push_item_width(float width) {
     assert_is_open();
-    ImGui::PushItemWidth(width);
+    stream().begin_command(CommandType::PushItemWidth);
+    stream().write(width);
 }
 
 void pop_item_width() {
     assert_is_open();
-    ImGui::PopItemWidth();
+    stream().begin_command(CommandType::PopItemWidth);
 }
 
 bool begin_tab_bar(const char *id) {
     assert_is_open();
-    return ImGui::BeginTabBar(id);
+    uint32_t key = item_key(id);
+    bool open = is_expanded(key, true);
+
+    stream().begin_command(CommandType::BeginTabBar, predicted_flags(open));
+    stream().write(key);
+    stream().write_str(id);
+    if (open) {
+        push_scope(key);
+    }
+
+    return open;
 }
 
 void end_tab_bar() {
     assert_is_open();
-    ImGui::EndTabBar();
+    stream().begin_command(CommandType::EndTabBar);
+    pop_scope();
 }
 
 bool begin_tab_item(const char *label, bool *open) {
     assert_is_open();
-    return ImGui::BeginTabItem(label, open);
+    uint32_t key = item_key(label);
+
+    bool active = is_expanded(key, false);
+    if (open != nullptr && was_closed(key)) {
+        *open = false;
+        active = false;
+    }
+
+    stream().begin_command(CommandType::BeginTabItem, predicted_flags(active) | bool_flags(open));
+    stream().write(key);
+    stream().write_str(label);
+    if (active) {
+        push_scope(key);
+    }
+
+    return active;
 }
 
 void end_tab_item() {
     assert_is_open();
-    ImGui::EndTabItem();
+    stream().begin_command(CommandType::EndTabItem);
+    pop_scope();
 }
 
 void push_str_id(const char *id) {
     assert_is_open();
-    ImGui::PushID(id);
+    stream().begin_command(CommandType::PushStrId);
+    stream().write_str(id);
+    push_scope(hash_str(id_stack.back(), id));
 }
 
 void pop_id() {
     assert_is_open();
-    ImGui::PopID();
+    stream().begin_command(CommandType::PopId);
+    pop_scope();
 }
 
 bool is_item_hovered() {
     assert_is_open();
-    return ImGui::IsItemHovered();
+    return has_result_flag(last_item_key, RESULT_HOVERED, false);
 }
 
 ImVec2 get_display_size() {
     assert_is_open();
-    return ImGui::GetIO().DisplaySize;
+    return backend::frame_results.display_size;
 }
 
 ImU32 color_float4_to_u32(const ImVec4 &in) {
@@ -239,42 +572,180 @@ ImU32 color_float4_to_u32(const ImVec4 &in) {
 
 void foreground_text(const ImVec2 &pos, ImU32 color, const char *text) {
     assert_is_open();
-    ImGui::GetForegroundDrawList()->AddText(pos, color, text);
+    stream().begin_command(CommandType::ForegroundText);
+    stream().write(pos);
+    stream().write(color);
+    stream().write_str(text);
 }
 
 void foreground_line(const ImVec2 &p1, const ImVec2 &p2, ImU32 color, float thickness) {
     assert_is_open();
-    ImGui::GetForegroundDrawList()->AddLine(p1, p2, color, thickness);
+    stream().begin_command(CommandType::ForegroundLine);
+    stream().write(p1);
+    stream().write(p2);
+    stream().write(color);
+    stream().write(thickness);
 }
 
 void foreground_circle(const ImVec2 &center, float radius, ImU32 color, int num_segments, float thickness) {
     assert_is_open();
-    ImGui::GetForegroundDrawList()->AddCircle(center, radius, color, num_segments, thickness);
+    stream().begin_command(CommandType::ForegroundCircle);
+    stream().write(center);
+    stream().write(radius);
+    stream().write(color);
+    stream().write<int32_t>(num_segments);
+    stream().write(thickness);
 }
 
 void foreground_circle_filled(const ImVec2 &center, float radius, ImU32 color, int num_segments) {
     assert_is_open();
-    ImGui::GetForegroundDrawList()->AddCircleFilled(center, radius, color, num_segments);
+    stream().begin_command(CommandType::ForegroundCircleFilled);
+    stream().write(center);
+    stream().write(radius);
+    stream().write(color);
+    stream().write<int32_t>(num_segments);
 }
 
 void foreground_ellipse(const ImVec2 &center, float radius_x, float radius_y, ImU32 color, float rot, int num_segments, float thickness) {
     assert_is_open();
-    ImGui::GetForegroundDrawList()->AddEllipse(center, radius_x, radius_y, color, rot, num_segments, thickness);
+    stream().begin_command(CommandType::ForegroundEllipse);
+    stream().write(center);
+    stream().write(radius_x);
+    stream().write(radius_y);
+    stream().write(color);
+    stream().write(rot);
+    stream().write<int32_t>(num_segments);
+    stream().write(thickness);
 }
 
 void foreground_ellipse_filled(const ImVec2 &center, float radius_x, float radius_y, ImU32 color, float rot, int num_segments) {
     assert_is_open();
-    ImGui::GetForegroundDrawList()->AddEllipseFilled(center, radius_x, radius_y, color, rot, num_segments);
+    stream().begin_command(CommandType::ForegroundEllipseFilled);
+    stream().write(center);
+    stream().write(radius_x);
+    stream().write(radius_y);
+    stream().write(color);
+    stream().write(rot);
+    stream().write<int32_t>(num_segments);
 }
 
 void foreground_rect(const ImVec2 &p_min, const ImVec2 &p_max, ImU32 color, float thickness) {
     assert_is_open();
-    ImGui::GetForegroundDrawList()->AddRect(p_min, p_max, color, 0, 0, thickness);
+    stream().begin_command(CommandType::ForegroundRect);
+    stream().write(p_min);
+    stream().write(p_max);
+    stream().write(color);
+    stream().write(thickness);
 }
 
 void foreground_rect_filled(const ImVec2 &p_min, const ImVec2 &p_max, ImU32 color) {
     assert_is_open();
-    ImGui::GetForegroundDrawList()->AddRectFilled(p_min, p_max, color);
+    stream().begin_command(CommandType::ForegroundRectFilled);
+    stream().write(p_min);
+    stream().write(p_max);
+    stream().write(color);
+}
+
+static int get_region_interval(const ThrottledRegion &region) {
+    int interval = region.user_interval > 0 ? region.user_interval : region.requested_interval;
+    if (b_auto_throttle && region_budget_ms > 0.0f) {
+        interval = std::max(interval, (int)std::ceil(region.avg_cost_ms / region_budget_ms));
+    }
+    return std::clamp(interval, 1, max_throttled_interval);
+}
+
+bool begin_throttled(const char *id, int interval) {
+    assert_is_open();
+    assert(cur_region == nullptr && "Throttled regions cannot be nested.");
+
+    ThrottledRegion &region = throttled_regions[id];
+    region.requested_interval = interval;
+    region.interval = get_region_interval(region);
+    region.last_frame = frame_count;
+    region.frames_since_update++;
+
+    // Anything that was clicked or edited has to be seen by the code that recorded it, so update everything
+    // while the user is interacting with the UI.
+    bool has_input = backend::frame_results_fresh && backend::frame_results.has_one_shot_results;
+
+    if (!region.has_commands || has_input || region.frames_since_update >= (uint32_t)region.interval) {
+        cur_region = &region;
+        cur_region_start = backend::record_stream.size();
+        cur_region_unlabeled_start = unlabeled_item_count;
+        cur_region_start_time = ThrottleClock::now();
+        return true;
+    }
+
+    backend::record_stream.append_commands(region.commands);
+    unlabeled_item_count += region.unlabeled_item_count;
+    return false;
+}
+
+void end_throttled() {
+    assert_is_open();
+    assert(cur_region != nullptr && "end_throttled called without a matching begin_throttled.");
+
+    std::chrono::duration<float, std::milli> cost = ThrottleClock::now() - cur_region_start_time;
+
+    ThrottledRegion &region = *cur_region;
+    backend::record_stream.copy_commands(cur_region_start, region.commands);
+    region.unlabeled_item_count = unlabeled_item_count - cur_region_unlabeled_start;
+    region.avg_cost_ms = region.has_commands ? (region.avg_cost_ms * 0.9f + cost.count() * 0.1f) : cost.count();
+    region.has_commands = true;
+    region.frames_since_update = 0;
+
+    cur_region = nullptr;
+}
+
+// The menu is drawn from the main menu bar, before the windows' regions are reached in the current frame, so
+// regions seen in the previous frame count as active too.
+static bool is_region_active(const ThrottledRegion &region) {
+    return region.last_frame + 1 >= frame_count;
+}
+
+void throttle_menu() {
+    assert_is_open();
+
+    float total_cost_ms = 0.0f;
+    for (const auto &[id, region] : throttled_regions) {
+        if (is_region_active(region)) {
+            total_cost_ms += region.avg_cost_ms / region.interval;
+        }
+    }
+
+    char label[128];
+    snprintf(label, sizeof(label), "Perf (%.2f ms)###DebugUIPerf", total_cost_ms);
+
+    if (begin_menu(label)) {
+        checkbox("Auto-throttle", &b_auto_throttle);
+        set_next_item_width(100.0f);
+        input_float_ext("Budget per window (ms)", &region_budget_ms, 0.1f, 1.0f, "%.2f", 0);
+        region_budget_ms = std::max(region_budget_ms, 0.0f);
+        separator();
+
+        for (auto &[id, region] : throttled_regions) {
+            if (!is_region_active(region)) {
+                continue;
+            }
+
+            push_str_id(id.c_str());
+
+            char stats[256];
+            snprintf(stats, sizeof(stats), "%s: %.2f ms, every %d tick%s", id.c_str(), region.avg_cost_ms,
+                region.interval, region.interval == 1 ? "" : "s");
+            text(stats);
+
+            same_line();
+            set_next_item_width(80.0f);
+            if (input_int("Interval", &region.user_interval)) {
+                region.user_interval = std::clamp(region.user_interval, 0, max_throttled_interval);
+            }
+
+            pop_id();
+        }
+
+        end_menu();
+    }
 }
 
 }
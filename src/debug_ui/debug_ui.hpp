@@ -78,4 +78,11 @@ void foreground_ellipse_filled(const ImVec2 &center, float radius_x, float radiu
 void foreground_rect(const ImVec2 &p_min, const ImVec2 &p_max, ImU32 color, float thickness);
 void foreground_rect_filled(const ImVec2 &p_min, const ImVec2 &p_max, ImU32 color);
 
+// Only re-records the region every interval frames, or less often if it goes over the frame-time budget.
+// Returns false if the previous recording was reused, in which case end_throttled must not be called.
+bool begin_throttled(const char *id, int interval);
+void end_throttled();
+// Menu bar menu with the measured cost of each throttled region and their update rate settings.
+void throttle_menu();
+
 }
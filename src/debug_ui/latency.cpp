@@ -0,0 +1,229 @@
+#include "latency.hpp"
+#include "debug_ui.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+#include "ultramodern/ultramodern.hpp"
+
+#include "input/input.hpp"
+
+namespace dino::debug_ui {
+
+enum class LatencyStage : uint8_t {
+    Idle,
+    // A new measurement has been claimed and its event time is being written.
+    Starting,
+    WaitingForConsume,
+    WaitingForDisplayList,
+    WaitingForPresent,
+};
+
+enum LatencySegment {
+    SEGMENT_EVENT_TO_CONSUME,
+    SEGMENT_CONSUME_TO_DISPLAY_LIST,
+    SEGMENT_DISPLAY_LIST_TO_PRESENT,
+    SEGMENT_TOTAL,
+    SEGMENT_COUNT
+};
+
+static const char *segment_names[SEGMENT_COUNT] = {
+    "Event -> game read",
+    "Game read -> display list",
+    "Display list -> present",
+    "Total",
+};
+
+// Measurements that never complete (e.g. the game stopped reading input while a menu is open) are abandoned
+// after this long so a new edge can be measured.
+static constexpr std::chrono::nanoseconds measurement_timeout = std::chrono::seconds(1);
+static constexpr size_t max_samples = 512;
+
+static std::atomic_bool enabled = false;
+// The current stage and a generation that's incremented for every new measurement, packed into one atomic. Each
+// stage is advanced with a compare-exchange by the thread that the stage is waiting on after writing its
+// timestamp, so a thread that was still working on an abandoned measurement can't advance the new one. This
+// way the timestamps don't need a lock.
+static std::atomic<uint32_t> state = 0;
+static std::atomic<int64_t> event_time_ns = 0;
+static std::atomic<int64_t> consume_time_ns = 0;
+static std::atomic<int64_t> display_list_time_ns = 0;
+
+static std::mutex samples_mutex;
+// Ring buffers of the most recent samples of each segment in milliseconds.
+static std::array<std::vector<float>, SEGMENT_COUNT> samples;
+static size_t next_sample = 0;
+static uint64_t measurement_count = 0;
+
+static uint32_t make_state(LatencyStage stage, uint32_t generation) {
+    return (generation << 8) | uint32_t(stage);
+}
+
+static LatencyStage get_stage(uint32_t cur_state) {
+    return LatencyStage(cur_state & 0xFF);
+}
+
+static uint32_t get_generation(uint32_t cur_state) {
+    return cur_state >> 8;
+}
+
+// Moves to the next stage of the same measurement, unless it was abandoned since cur_state was read.
+static bool advance_stage(uint32_t cur_state, LatencyStage next_stage) {
+    return state.compare_exchange_strong(cur_state, make_state(next_stage, get_generation(cur_state)));
+}
+
+static int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(ultramodern::time_since_start()).count();
+}
+
+bool latency_measurement_enabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void latency_input_edge() {
+    if (!latency_measurement_enabled()) {
+        return;
+    }
+
+    int64_t now = now_ns();
+    uint32_t cur_state = state.load();
+    LatencyStage cur_stage = get_stage(cur_state);
+    if (cur_stage == LatencyStage::Starting ||
+        (cur_stage != LatencyStage::Idle && now - event_time_ns.load() < measurement_timeout.count()))
+    {
+        return;
+    }
+
+    // Claim the new measurement before writing its event time, which abandons the one in progress (if any).
+    uint32_t generation = get_generation(cur_state) + 1;
+    if (!state.compare_exchange_strong(cur_state, make_state(LatencyStage::Starting, generation))) {
+        return;
+    }
+
+    event_time_ns.store(now);
+    state.store(make_state(LatencyStage::WaitingForConsume, generation));
+}
+
+void latency_input_consumed() {
+    uint32_t cur_state = state.load();
+    if (!latency_measurement_enabled() || get_stage(cur_state) != LatencyStage::WaitingForConsume) {
+        return;
+    }
+
+    // Only count the read once it's from a sample that was taken after the edge happened.
+    if (std::chrono::nanoseconds(event_time_ns.load()) > dino::input::get_input_sample_time()) {
+        return;
+    }
+
+    consume_time_ns.store(now_ns());
+    advance_stage(cur_state, LatencyStage::WaitingForDisplayList);
+}
+
+void latency_display_list_sent() {
+    uint32_t cur_state = state.load();
+    if (!latency_measurement_enabled() || get_stage(cur_state) != LatencyStage::WaitingForDisplayList) {
+        return;
+    }
+
+    display_list_time_ns.store(now_ns());
+    advance_stage(cur_state, LatencyStage::WaitingForPresent);
+}
+
+void latency_screen_presented() {
+    uint32_t cur_state = state.load();
+    if (!latency_measurement_enabled() || get_stage(cur_state) != LatencyStage::WaitingForPresent) {
+        return;
+    }
+
+    int64_t present_time = now_ns();
+    int64_t times[] = { event_time_ns.load(), consume_time_ns.load(), display_list_time_ns.load(), present_time };
+
+    // Only record the sample if the measurement is still the one the timestamps were read for.
+    if (!advance_stage(cur_state, LatencyStage::Idle)) {
+        return;
+    }
+
+    std::lock_guard lock{ samples_mutex };
+    float segment_ms[SEGMENT_COUNT] = {
+        (times[1] - times[0]) / 1e6f,
+        (times[2] - times[1]) / 1e6f,
+        (times[3] - times[2]) / 1e6f,
+        (times[3] - times[0]) / 1e6f,
+    };
+
+    for (size_t i = 0; i < SEGMENT_COUNT; i++) {
+        if (samples[i].size() < max_samples) {
+            samples[i].push_back(segment_ms[i]);
+        }
+        else {
+            samples[i][next_sample] = segment_ms[i];
+        }
+    }
+
+    next_sample = (next_sample + 1) % max_samples;
+    measurement_count++;
+}
+
+static float percentile(const std::vector<float> &sorted, float p) {
+    size_t index = std::min(size_t(p * (sorted.size() - 1) + 0.5f), sorted.size() - 1);
+    return sorted[index];
+}
+
+void latency_tab() {
+    bool b_enabled = enabled.load();
+    if (checkbox("Measure input latency", &b_enabled)) {
+        enabled.store(b_enabled);
+        state.store(make_state(LatencyStage::Idle, get_generation(state.load()) + 1));
+    }
+
+    same_line();
+    bool reset = button("Reset");
+
+    std::array<std::vector<float>, SEGMENT_COUNT> sorted;
+    uint64_t count;
+    {
+        std::lock_guard lock{ samples_mutex };
+        if (reset) {
+            for (std::vector<float> &segment_samples : samples) {
+                segment_samples.clear();
+            }
+            next_sample = 0;
+            measurement_count = 0;
+        }
+
+        sorted = samples;
+        count = measurement_count;
+    }
+
+    text("Press any key or controller button to take a measurement.");
+
+    char line[256];
+    snprintf(line, sizeof(line), "Measurements: %llu (last %zu shown)", (unsigned long long)(count), sorted[SEGMENT_TOTAL].size());
+    text(line);
+    if (sorted[SEGMENT_TOTAL].empty()) {
+        return;
+    }
+
+    separator();
+    for (size_t i = 0; i < SEGMENT_COUNT; i++) {
+        std::vector<float> &segment_samples = sorted[i];
+        std::sort(segment_samples.begin(), segment_samples.end());
+
+        float sum = 0.0f;
+        for (float sample : segment_samples) {
+            sum += sample;
+        }
+
+        snprintf(line, sizeof(line), "%.2f min, %.2f avg, %.2f p50, %.2f p95, %.2f p99, %.2f max (ms)",
+            segment_samples.front(), sum / segment_samples.size(), percentile(segment_samples, 0.5f),
+            percentile(segment_samples, 0.95f), percentile(segment_samples, 0.99f), segment_samples.back());
+        label_text(segment_names[i], line);
+    }
+}
+
+}
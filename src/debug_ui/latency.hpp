@@ -0,0 +1,18 @@
+#pragma once
+
+namespace dino::debug_ui {
+
+// Input-to-photon latency measurement. While enabled, an input edge is followed from the SDL event through the game
+// reading it, the next display list and the present that follows, one edge at a time.
+bool latency_measurement_enabled();
+
+// Pipeline stages, called from the thread each one happens on.
+void latency_input_edge();
+void latency_input_consumed();
+void latency_display_list_sent();
+void latency_screen_presented();
+
+// Draws the measurement controls and the latency distribution of each stage.
+void latency_tab();
+
+}
@@ -0,0 +1,449 @@
+#include "commands.hpp"
+
+#include "imgui/imgui.h"
+#include "imgui/imgui_internal.h"
+
+namespace dino::debug_ui {
+
+static CommandHeader read_header(const uint8_t *cmd) {
+    CommandHeader header;
+    memcpy(&header, cmd, sizeof(header));
+    return header;
+}
+
+// Whether the command opens a scope that has a matching closing command in the stream.
+static bool opens_scope(const CommandHeader &header) {
+    switch (header.type) {
+        case CommandType::Begin:
+        case CommandType::BeginChild:
+            return true;
+        case CommandType::BeginCombo:
+        case CommandType::BeginMainMenuBar:
+        case CommandType::BeginMenu:
+        case CommandType::TreeNode:
+        case CommandType::BeginTabBar:
+        case CommandType::BeginTabItem:
+            return (header.flags & COMMAND_FLAG_PREDICTED_OPEN) != 0;
+        default:
+            return false;
+    }
+}
+
+static bool closes_scope(const CommandHeader &header) {
+    switch (header.type) {
+        case CommandType::End:
+        case CommandType::EndChild:
+        case CommandType::EndCombo:
+        case CommandType::EndMainMenuBar:
+        case CommandType::EndMenu:
+        case CommandType::TreePop:
+        case CommandType::EndTabBar:
+        case CommandType::EndTabItem:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Returns the closing command of the scope whose contents start at cmd, or end if the scope was never closed.
+static const uint8_t *find_scope_end(const uint8_t *cmd, const uint8_t *end) {
+    int depth = 1;
+
+    while (cmd < end) {
+        CommandHeader header = read_header(cmd);
+        if (opens_scope(header)) {
+            depth++;
+        } else if (closes_scope(header)) {
+            depth--;
+            if (depth == 0) {
+                return cmd;
+            }
+        }
+        cmd += header.size;
+    }
+
+    return end;
+}
+
+// The game thread decides whether to record the contents of a scope based on last frame's results, so ImGui
+// may disagree with it this frame. Reconciles the two for scopes that are only closed when open.
+static const uint8_t *reconcile_scope(bool predicted_open, bool open, const uint8_t *next, const uint8_t *end, void (*close_scope)()) {
+    if (predicted_open && !open) {
+        // Skip the recorded contents along with the closing command, since ImGui doesn't want it called.
+        const uint8_t *scope_end = find_scope_end(next, end);
+        return scope_end < end ? scope_end + read_header(scope_end).size : end;
+    }
+
+    if (!predicted_open && open) {
+        // Nothing was recorded for this scope, close it right away.
+        close_scope();
+    }
+
+    return next;
+}
+
+// Same as reconcile_scope, but for scopes that are always closed (windows and child windows).
+static const uint8_t *reconcile_window(bool predicted_open, bool open, const uint8_t *next, const uint8_t *end) {
+    if (predicted_open && !open) {
+        // Skip the contents but still run the closing command.
+        return find_scope_end(next, end);
+    }
+
+    return next;
+}
+
+static void set_result_flag(WidgetResult &result, uint8_t flag, bool value) {
+    if (value) {
+        result.flags |= flag;
+    } else {
+        result.flags &= ~flag;
+    }
+}
+
+static void record_item(FrameResults &results, uint32_t key, bool activated) {
+    WidgetResult &result = results.widgets[key];
+    set_result_flag(result, RESULT_ACTIVATED, activated);
+    results.has_one_shot_results |= activated;
+    set_result_flag(result, RESULT_HOVERED, ImGui::IsItemHovered());
+}
+
+static WidgetResult &record_expanded(FrameResults &results, uint32_t key, bool expanded) {
+    WidgetResult &result = results.widgets[key];
+    set_result_flag(result, RESULT_EXPANDED, expanded);
+    return result;
+}
+
+static std::vector<char> input_text_buffer{};
+
+void replay_commands(const CommandStream &stream, FrameResults &results) {
+    const uint8_t *cmd = stream.begin();
+    const uint8_t *end = stream.end();
+
+    while (cmd < end) {
+        CommandHeader header = read_header(cmd);
+        CommandReader reader{ cmd + sizeof(CommandHeader) };
+        const uint8_t *next = cmd + header.size;
+
+        bool predicted_open = (header.flags & COMMAND_FLAG_PREDICTED_OPEN) != 0;
+        bool has_bool = (header.flags & COMMAND_FLAG_HAS_BOOL) != 0;
+        bool bool_value = (header.flags & COMMAND_FLAG_BOOL_VALUE) != 0;
+
+        switch (header.type) {
+            case CommandType::Begin: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *name = reader.read_str();
+                bool open = bool_value;
+                bool expanded = ImGui::Begin(name, has_bool ? &open : nullptr);
+                WidgetResult &result = record_expanded(results, key, expanded);
+                set_result_flag(result, RESULT_CLOSED, has_bool && !open);
+                results.has_one_shot_results |= has_bool && !open;
+                next = reconcile_window(predicted_open, expanded, next, end);
+                break;
+            }
+            case CommandType::End:
+                ImGui::End();
+                break;
+            case CommandType::Text: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *text = reader.read_str();
+                ImGui::TextUnformatted(text);
+                record_item(results, key, false);
+                break;
+            }
+            case CommandType::LabelText: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *label = reader.read_str();
+                const char *text = reader.read_str();
+                ImGui::LabelText(label, "%s", text);
+                record_item(results, key, false);
+                break;
+            }
+            case CommandType::SameLine:
+                ImGui::SameLine();
+                break;
+            case CommandType::NewLine:
+                ImGui::NewLine();
+                break;
+            case CommandType::Separator:
+                ImGui::Separator();
+                break;
+            case CommandType::BeginCombo: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *label = reader.read_str();
+                const char *preview = reader.read_str();
+                bool open = ImGui::BeginCombo(label, preview);
+                record_expanded(results, key, open);
+                next = reconcile_scope(predicted_open, open, next, end, ImGui::EndCombo);
+                break;
+            }
+            case CommandType::EndCombo:
+                ImGui::EndCombo();
+                break;
+            case CommandType::Selectable: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *label = reader.read_str();
+                bool selected = bool_value;
+                bool pressed = ImGui::Selectable(label, &selected);
+                record_item(results, key, pressed);
+                break;
+            }
+            case CommandType::Button: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *label = reader.read_str();
+                bool pressed = ImGui::Button(label);
+                record_item(results, key, pressed);
+                break;
+            }
+            case CommandType::BeginMainMenuBar: {
+                uint32_t key = reader.read<uint32_t>();
+                bool open = ImGui::BeginMainMenuBar();
+                record_expanded(results, key, open);
+                next = reconcile_scope(predicted_open, open, next, end, ImGui::EndMainMenuBar);
+                break;
+            }
+            case CommandType::EndMainMenuBar:
+                ImGui::EndMainMenuBar();
+                break;
+            case CommandType::BeginMenu: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *label = reader.read_str();
+                bool open = ImGui::BeginMenu(label);
+                record_expanded(results, key, open);
+                next = reconcile_scope(predicted_open, open, next, end, ImGui::EndMenu);
+                break;
+            }
+            case CommandType::EndMenu:
+                ImGui::EndMenu();
+                break;
+            case CommandType::MenuItem: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *label = reader.read_str();
+                bool selected = bool_value;
+                bool pressed = ImGui::MenuItem(label, NULL, has_bool ? &selected : nullptr);
+                record_item(results, key, pressed);
+                set_result_flag(results.widgets[key], RESULT_BOOL_VALUE, selected);
+                break;
+            }
+            case CommandType::CollapsingHeader: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *label = reader.read_str();
+                bool open = ImGui::CollapsingHeader(label);
+                record_item(results, key, false);
+                record_expanded(results, key, open);
+                break;
+            }
+            case CommandType::TreeNode: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *label = reader.read_str();
+                bool open = ImGui::TreeNode(label);
+                record_expanded(results, key, open);
+                next = reconcile_scope(predicted_open, open, next, end, ImGui::TreePop);
+                break;
+            }
+            case CommandType::TreePop:
+                ImGui::TreePop();
+                break;
+            case CommandType::BeginChild: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *str_id = reader.read_str();
+                bool open = ImGui::BeginChild(str_id);
+                record_expanded(results, key, open);
+                next = reconcile_window(predicted_open, open, next, end);
+                break;
+            }
+            case CommandType::EndChild:
+                ImGui::EndChild();
+                break;
+            case CommandType::Checkbox: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *label = reader.read_str();
+                bool value = bool_value;
+                bool pressed = ImGui::Checkbox(label, &value);
+                record_item(results, key, pressed);
+                set_result_flag(results.widgets[key], RESULT_BOOL_VALUE, value);
+                break;
+            }
+            case CommandType::InputInt: {
+                uint32_t key = reader.read<uint32_t>();
+                int value = reader.read<int32_t>();
+                int step = reader.read<int32_t>();
+                int step_fast = reader.read<int32_t>();
+                ImGuiInputTextFlags flags = reader.read<int32_t>();
+                const char *label = reader.read_str();
+                bool changed = ImGui::InputInt(label, &value, step, step_fast, flags);
+                record_item(results, key, changed);
+                results.widgets[key].int_value = value;
+                break;
+            }
+            case CommandType::InputFloat: {
+                uint32_t key = reader.read<uint32_t>();
+                float value = reader.read<float>();
+                float step = reader.read<float>();
+                float step_fast = reader.read<float>();
+                ImGuiInputTextFlags flags = reader.read<int32_t>();
+                const char *label = reader.read_str();
+                const char *format = reader.read_str();
+                bool changed = ImGui::InputFloat(label, &value, step, step_fast, format, flags);
+                record_item(results, key, changed);
+                results.widgets[key].float_value = value;
+                break;
+            }
+            case CommandType::InputText: {
+                uint32_t key = reader.read<uint32_t>();
+                uint32_t buf_size = reader.read<uint32_t>();
+                ImGuiInputTextFlags flags = reader.read<int32_t>();
+                const char *label = reader.read_str();
+                const char *text = reader.read_str();
+
+                // ImGui edits the buffer in place, so give it a copy with the game's buffer size.
+                input_text_buffer.assign(buf_size, '\0');
+                if (buf_size > 0) {
+                    strncpy(input_text_buffer.data(), text, buf_size - 1);
+                }
+
+                bool changed = ImGui::InputText(label, input_text_buffer.data(), buf_size, flags);
+                record_item(results, key, changed);
+                if (changed) {
+                    results.texts[key] = input_text_buffer.data();
+                }
+                break;
+            }
+            case CommandType::SetNextItemWidth:
+                ImGui::SetNextItemWidth(reader.read<float>());
+                break;
+            case CommandType::PushItemWidth:
+                ImGui::PushItemWidth(reader.read<float>());
+                break;
+            case CommandType::PopItemWidth:
+                ImGui::PopItemWidth();
+                break;
+            case CommandType::BeginTabBar: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *id = reader.read_str();
+                bool open = ImGui::BeginTabBar(id);
+                record_expanded(results, key, open);
+                next = reconcile_scope(predicted_open, open, next, end, ImGui::EndTabBar);
+                break;
+            }
+            case CommandType::EndTabBar:
+                ImGui::EndTabBar();
+                break;
+            case CommandType::BeginTabItem: {
+                uint32_t key = reader.read<uint32_t>();
+                const char *label = reader.read_str();
+                bool open = bool_value;
+                bool active = ImGui::BeginTabItem(label, has_bool ? &open : nullptr);
+                WidgetResult &result = record_expanded(results, key, active);
+                set_result_flag(result, RESULT_CLOSED, has_bool && !open);
+                results.has_one_shot_results |= has_bool && !open;
+                next = reconcile_scope(predicted_open, active, next, end, ImGui::EndTabItem);
+                break;
+            }
+            case CommandType::EndTabItem:
+                ImGui::EndTabItem();
+                break;
+            case CommandType::PushStrId:
+                ImGui::PushID(reader.read_str());
+                break;
+            case CommandType::PopId:
+                ImGui::PopID();
+                break;
+            case CommandType::ForegroundText: {
+                ImVec2 pos = reader.read<ImVec2>();
+                ImU32 color = reader.read<ImU32>();
+                const char *text = reader.read_str();
+                ImGui::GetForegroundDrawList()->AddText(pos, color, text);
+                break;
+            }
+            case CommandType::ForegroundLine: {
+                ImVec2 p1 = reader.read<ImVec2>();
+                ImVec2 p2 = reader.read<ImVec2>();
+                ImU32 color = reader.read<ImU32>();
+                float thickness = reader.read<float>();
+                ImGui::GetForegroundDrawList()->AddLine(p1, p2, color, thickness);
+                break;
+            }
+            case CommandType::ForegroundCircle: {
+                ImVec2 center = reader.read<ImVec2>();
+                float radius = reader.read<float>();
+                ImU32 color = reader.read<ImU32>();
+                int num_segments = reader.read<int32_t>();
+                float thickness = reader.read<float>();
+                ImGui::GetForegroundDrawList()->AddCircle(center, radius, color, num_segments, thickness);
+                break;
+            }
+            case CommandType::ForegroundCircleFilled: {
+                ImVec2 center = reader.read<ImVec2>();
+                float radius = reader.read<float>();
+                ImU32 color = reader.read<ImU32>();
+                int num_segments = reader.read<int32_t>();
+                ImGui::GetForegroundDrawList()->AddCircleFilled(center, radius, color, num_segments);
+                break;
+            }
+            case CommandType::ForegroundEllipse: {
+                ImVec2 center = reader.read<ImVec2>();
+                float radius_x = reader.read<float>();
+                float radius_y = reader.read<float>();
+                ImU32 color = reader.read<ImU32>();
+                float rot = reader.read<float>();
+                int num_segments = reader.read<int32_t>();
+                float thickness = reader.read<float>();
+                ImGui::GetForegroundDrawList()->AddEllipse(center, radius_x, radius_y, color, rot, num_segments, thickness);
+                break;
+            }
+            case CommandType::ForegroundEllipseFilled: {
+                ImVec2 center = reader.read<ImVec2>();
+                float radius_x = reader.read<float>();
+                float radius_y = reader.read<float>();
+                ImU32 color = reader.read<ImU32>();
+                float rot = reader.read<float>();
+                int num_segments = reader.read<int32_t>();
+                ImGui::GetForegroundDrawList()->AddEllipseFilled(center, radius_x, radius_y, color, rot, num_segments);
+                break;
+            }
+            case CommandType::ForegroundRect: {
+                ImVec2 p_min = reader.read<ImVec2>();
+                ImVec2 p_max = reader.read<ImVec2>();
+                ImU32 color = reader.read<ImU32>();
+                float thickness = reader.read<float>();
+                ImGui::GetForegroundDrawList()->AddRect(p_min, p_max, color, 0, 0, thickness);
+                break;
+            }
+            case CommandType::ForegroundRectFilled: {
+                ImVec2 p_min = reader.read<ImVec2>();
+                ImVec2 p_max = reader.read<ImVec2>();
+                ImU32 color = reader.read<ImU32>();
+                ImGui::GetForegroundDrawList()->AddRectFilled(p_min, p_max, color);
+                break;
+            }
+        }
+
+        cmd = next;
+    }
+}
+
+void FrameResults::merge_unconsumed(const FrameResults &older) {
+    for (const auto &[key, older_result] : older.widgets) {
+        uint8_t one_shot = older_result.flags & one_shot_result_flags;
+        if (one_shot == 0) {
+            continue;
+        }
+
+        WidgetResult &result = widgets[key];
+        if ((result.flags & RESULT_ACTIVATED) == 0 && (older_result.flags & RESULT_ACTIVATED) != 0) {
+            // Keep the edited value along with the activation.
+            result.int_value = older_result.int_value;
+            result.float_value = older_result.float_value;
+            set_result_flag(result, RESULT_BOOL_VALUE, (older_result.flags & RESULT_BOOL_VALUE) != 0);
+        }
+        result.flags |= one_shot;
+    }
+
+    for (const auto &[key, text] : older.texts) {
+        texts.try_emplace(key, text);
+    }
+
+    has_one_shot_results |= older.has_one_shot_results;
+}
+
+}
@@ -0,0 +1,46 @@
+#include "texture_packs.hpp"
+#include "debug_ui.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+#include "renderer/renderer.hpp"
+
+namespace dino::debug_ui {
+
+static double to_ms(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void texture_packs_tab() {
+    dino::renderer::TexturePackStats stats = dino::renderer::get_texture_pack_stats();
+
+    char line[256];
+    label_text("Status", stats.loading ? "Loading" : "Idle");
+
+    snprintf(line, sizeof(line), "%llu (%llu unchanged)", (unsigned long long)(stats.load_count), (unsigned long long)(stats.skipped_load_count));
+    label_text("Loads", line);
+
+    snprintf(line, sizeof(line), "%.2f ms last, %.2f ms total", to_ms(stats.last_load_time), to_ms(stats.total_load_time));
+    label_text("Load time", line);
+
+    uintmax_t total_size = 0;
+    for (const dino::renderer::TexturePackStats::Pack &pack : stats.loaded_packs) {
+        total_size += pack.file_size;
+    }
+
+    snprintf(line, sizeof(line), "%zu (%.1f MiB)", stats.loaded_packs.size(), total_size / (1024.0 * 1024.0));
+    label_text("Loaded packs", line);
+
+    if (stats.loaded_packs.empty()) {
+        return;
+    }
+
+    separator();
+    for (const dino::renderer::TexturePackStats::Pack &pack : stats.loaded_packs) {
+        snprintf(line, sizeof(line), "%.1f MiB, %s", pack.file_size / (1024.0 * 1024.0), pack.path.filename().string().c_str());
+        label_text(pack.mod_id.c_str(), line);
+    }
+}
+
+}
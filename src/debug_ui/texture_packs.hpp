@@ -0,0 +1,8 @@
+#pragma once
+
+namespace dino::debug_ui {
+
+// Draws the texture packs that are loaded into RT64 and statistics about how long loading them took.
+void texture_packs_tab();
+
+}
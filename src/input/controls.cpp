@@ -2,6 +2,8 @@
 
 #include <array>
 
+#include "debug_ui/latency.hpp"
+
 namespace dino::input {
 
 // Arrays that hold the mappings for every input for keyboard and controller respectively.
@@ -10,6 +12,15 @@ using input_mapping_array = std::array<input_mapping, static_cast<size_t>(GameIn
 static input_mapping_array keyboard_input_mappings{};
 static input_mapping_array controller_input_mappings{};
 
+// The mappings above compiled for resolving, updated whenever a binding changes.
+using compiled_binding_array = std::array<CompiledBinding, static_cast<size_t>(GameInput::COUNT)>;
+static compiled_binding_array keyboard_compiled_bindings = [] {
+    compiled_binding_array ret;
+    ret.fill(compile_binding({}));
+    return ret;
+}();
+static compiled_binding_array controller_compiled_bindings = keyboard_compiled_bindings;
+
 // Make the button value array, which maps a button index to its bit field.
 #define DEFINE_INPUT(name, value, readable) uint16_t(value##u),
 static const std::array n64_button_values = {
@@ -72,6 +83,9 @@ void set_input_binding(GameInput input, size_t binding_index, InputDevice device
 
     if (binding_index < cur_input_mapping.size()) {
         cur_input_mapping[binding_index] = value;
+
+        compiled_binding_array& device_compiled_bindings = (device == InputDevice::Controller) ? controller_compiled_bindings : keyboard_compiled_bindings;
+        device_compiled_bindings.at(static_cast<size_t>(input)) = compile_binding(cur_input_mapping);
     }
 }
 
@@ -85,27 +99,32 @@ bool get_n64_input(int controller_num, uint16_t* buttons_out, float* x_out, floa
     }
 
     if (!game_input_disabled()) {
+        // Resolve every binding against the same snapshot.
+        acquire_input_snapshot();
+
         for (size_t i = 0; i < n64_button_values.size(); i++) {
             size_t input_index = (size_t)GameInput::N64_BUTTON_START + i;
-            cur_buttons |= get_input_digital(keyboard_input_mappings[input_index]) ? n64_button_values[i] : 0;
-            cur_buttons |= get_input_digital(controller_input_mappings[input_index]) ? n64_button_values[i] : 0;
+            cur_buttons |= get_input_digital(keyboard_compiled_bindings[input_index]) ? n64_button_values[i] : 0;
+            cur_buttons |= get_input_digital(controller_compiled_bindings[input_index]) ? n64_button_values[i] : 0;
         }
 
         float joystick_deadzone = get_joystick_deadzone() / 100.0f;
 
-        float joystick_x = get_input_analog(controller_input_mappings[(size_t)GameInput::X_AXIS_POS])
-                        - get_input_analog(controller_input_mappings[(size_t)GameInput::X_AXIS_NEG]);
+        float joystick_x = get_input_analog(controller_compiled_bindings[(size_t)GameInput::X_AXIS_POS])
+                        - get_input_analog(controller_compiled_bindings[(size_t)GameInput::X_AXIS_NEG]);
 
-        float joystick_y = get_input_analog(controller_input_mappings[(size_t)GameInput::Y_AXIS_POS])
-                        - get_input_analog(controller_input_mappings[(size_t)GameInput::Y_AXIS_NEG]);
+        float joystick_y = get_input_analog(controller_compiled_bindings[(size_t)GameInput::Y_AXIS_POS])
+                        - get_input_analog(controller_compiled_bindings[(size_t)GameInput::Y_AXIS_NEG]);
 
         apply_joystick_deadzone(joystick_x, joystick_y, &joystick_x, &joystick_y);
 
-        cur_x = get_input_analog(keyboard_input_mappings[(size_t)GameInput::X_AXIS_POS])
-                - get_input_analog(keyboard_input_mappings[(size_t)GameInput::X_AXIS_NEG]) + joystick_x;
+        cur_x = get_input_analog(keyboard_compiled_bindings[(size_t)GameInput::X_AXIS_POS])
+                - get_input_analog(keyboard_compiled_bindings[(size_t)GameInput::X_AXIS_NEG]) + joystick_x;
+
+        cur_y = get_input_analog(keyboard_compiled_bindings[(size_t)GameInput::Y_AXIS_POS])
+                - get_input_analog(keyboard_compiled_bindings[(size_t)GameInput::Y_AXIS_NEG]) + joystick_y;
 
-        cur_y = get_input_analog(keyboard_input_mappings[(size_t)GameInput::Y_AXIS_POS])
-                - get_input_analog(keyboard_input_mappings[(size_t)GameInput::Y_AXIS_NEG]) + joystick_y;
+        dino::debug_ui::latency_input_consumed();
     }
 
     *buttons_out = cur_buttons;
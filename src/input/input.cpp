@@ -2,11 +2,13 @@
 
 #include <atomic>
 #include <mutex>
+#include <thread>
 
 #include "ultramodern/ultramodern.hpp"
 
 #include "config/config.hpp"
 #include "debug_ui/debug_ui.hpp"
+#include "debug_ui/latency.hpp"
 #include "promptfont.h"
 #include "GamepadMotion.hpp"
 #include "ui/recomp_ui.h"
@@ -26,20 +28,96 @@ struct ControllerState {
     };
 };
 
+// Every key, controller button and half axis is a digital input source with its own bit in an InputSourceMask, so
+// bindings can be compiled into masks and checked against a snapshot with a few bitwise operations.
+using InputSourceMask = std::array<uint64_t, dino::input::input_source_mask_words>;
+constexpr size_t key_source_start = 0;
+constexpr size_t button_source_start = key_source_start + SDL_NUM_SCANCODES;
+constexpr size_t half_axis_source_start = button_source_start + SDL_CONTROLLER_BUTTON_MAX;
+constexpr size_t half_axis_count = SDL_CONTROLLER_AXIS_MAX * 2;
+constexpr size_t input_source_count = half_axis_source_start + half_axis_count;
+static_assert(input_source_count <= dino::input::input_source_mask_words * 64, "Input source mask is too small");
+
+static void set_source_bit(InputSourceMask& mask, size_t source) {
+    mask[source / 64] |= uint64_t(1) << (source % 64);
+}
+
+static bool test_source_bit(const InputSourceMask& mask, size_t source) {
+    return (mask[source / 64] & (uint64_t(1) << (source % 64))) != 0;
+}
+
+static bool any_source_bits(const InputSourceMask& a, const InputSourceMask& b, const InputSourceMask& exclude) {
+    uint64_t ret = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        ret |= a[i] & b[i] & ~exclude[i];
+    }
+    return ret != 0;
+}
+
+// Half axes are stored with the positive half of each axis first.
+static size_t get_half_axis_index(SDL_GameControllerAxis axis, bool negative_range) {
+    return size_t(axis) * 2 + (negative_range ? 1 : 0);
+}
+
+static InputSourceMask make_half_axis_mask(std::initializer_list<SDL_GameControllerAxis> axes) {
+    InputSourceMask ret{};
+    for (SDL_GameControllerAxis axis : axes) {
+        set_source_bit(ret, half_axis_source_start + get_half_axis_index(axis, false));
+        set_source_bit(ret, half_axis_source_start + get_half_axis_index(axis, true));
+    }
+    return ret;
+}
+
+static const InputSourceMask no_sources{};
+static const InputSourceMask all_half_axis_sources = make_half_axis_mask({
+    SDL_CONTROLLER_AXIS_LEFTX, SDL_CONTROLLER_AXIS_LEFTY, SDL_CONTROLLER_AXIS_RIGHTX, SDL_CONTROLLER_AXIS_RIGHTY,
+    SDL_CONTROLLER_AXIS_TRIGGERLEFT, SDL_CONTROLLER_AXIS_TRIGGERRIGHT });
+static const InputSourceMask right_analog_sources = make_half_axis_mask({ SDL_CONTROLLER_AXIS_RIGHTX, SDL_CONTROLLER_AXIS_RIGHTY });
+
+// Immutable copy of all key and controller state, captured once per poll. Bindings are resolved against it with plain
+// array lookups instead of querying SDL for every binding.
+struct InputSnapshot {
+    // Held keys (taking should_override_keystate into account), buttons held on any controller and half axes past
+    // the digital threshold.
+    InputSourceMask digital_sources{};
+    // Half axes, summed over all controllers and clamped to [0, 1].
+    std::array<float, half_axis_count> controller_half_axes{};
+    // Gyro rotation and mouse motion accumulated since startup. Consumers take deltas between the totals of two
+    // snapshots, so no motion is lost when a snapshot gets skipped.
+    std::array<double, 2> total_rotation{};
+    std::array<double, 2> total_mouse_motion{};
+    // When the snapshot was captured, relative to ultramodern's start time.
+    std::chrono::nanoseconds sample_time{};
+};
+
+// Triple buffered handoff of snapshots. poll_inputs fills the back snapshot and swaps it with the ready one, and
+// acquire_input_snapshot swaps the ready one with the front snapshot that bindings are resolved against.
+static InputSnapshot input_snapshots[3];
+static constexpr uint8_t snapshot_index_mask = 0x3;
+static constexpr uint8_t snapshot_new_bit = 0x4;
+static uint8_t back_snapshot = 0;
+static std::atomic_uint8_t ready_snapshot = 1;
+static uint8_t front_snapshot = 2;
+
 static struct {
-    const Uint8* keys = nullptr;
-    SDL_Keymod keymod = SDL_Keymod::KMOD_NONE;
-    int numkeys = 0;
     std::atomic_int32_t mouse_wheel_pos = 0;
+    // Guards controller_states and cur_controllers, and serializes taking snapshots.
     std::mutex cur_controllers_mutex;
     std::vector<SDL_GameController*> cur_controllers{};
     std::unordered_map<SDL_JoystickID, ControllerState> controller_states;
     
     std::array<float, 2> rotation_delta{};
     std::array<float, 2> mouse_delta{};
-    std::mutex pending_input_mutex;
-    std::array<float, 2> pending_rotation_delta{};
-    std::array<float, 2> pending_mouse_delta{};
+    std::array<double, 2> polled_total_rotation{};
+    std::array<double, 2> polled_total_mouse_motion{};
+    // Only written by the event thread, so they can be accumulated without a lock.
+    std::array<std::atomic<double>, 2> total_rotation{};
+    std::array<std::atomic<double>, 2> total_mouse_motion{};
+
+    // Optional thread that takes snapshots at a fixed rate instead of only when the game polls.
+    std::thread sampling_thread;
+    std::atomic_bool sampling_thread_running = false;
+    int sampling_rate = 0;
 
     float cur_rumble;
     bool rumble_active;
@@ -104,6 +182,12 @@ bool should_override_keystate(SDL_Scancode key, SDL_Keymod mod) {
 }
 
 bool sdl_event_filter(void* userdata, SDL_Event* event) {
+    // Key and button presses and releases are the edges followed by the latency measurement.
+    if ((event->type == SDL_EventType::SDL_KEYDOWN && !event->key.repeat) || event->type == SDL_EventType::SDL_KEYUP ||
+        event->type == SDL_EventType::SDL_CONTROLLERBUTTONDOWN || event->type == SDL_EventType::SDL_CONTROLLERBUTTONUP) {
+        dino::debug_ui::latency_input_edge();
+    }
+
     switch (event->type) {
     case SDL_EventType::SDL_KEYDOWN:
         {
@@ -144,6 +228,7 @@ bool sdl_event_filter(void* userdata, SDL_Event* event) {
             printf("Controller added: %d\n", controller_event->which);
             if (controller != nullptr) {
                 printf("  Instance ID: %d\n", SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(controller)));
+                std::lock_guard lock{ InputState.cur_controllers_mutex };
                 ControllerState& state = InputState.controller_states[SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(controller))];
                 state.controller = controller;
 
@@ -158,6 +243,7 @@ bool sdl_event_filter(void* userdata, SDL_Event* event) {
         {
             SDL_ControllerDeviceEvent* controller_event = &event->cdevice;
             printf("Controller removed: %d\n", controller_event->which);
+            std::lock_guard lock{ InputState.cur_controllers_mutex };
             InputState.controller_states.erase(controller_event->which);
         }
         break;
@@ -246,6 +332,7 @@ bool sdl_event_filter(void* userdata, SDL_Event* event) {
             float x = event->csensor.data[0] / SDL_STANDARD_GRAVITY;
             float y = event->csensor.data[1] / SDL_STANDARD_GRAVITY;
             float z = event->csensor.data[2] / SDL_STANDARD_GRAVITY;
+            std::lock_guard lock{ InputState.cur_controllers_mutex };
             ControllerState& state = InputState.controller_states[event->csensor.which];
             state.latest_accelerometer[0] = x;
             state.latest_accelerometer[1] = y;
@@ -258,6 +345,7 @@ bool sdl_event_filter(void* userdata, SDL_Event* event) {
             float x = event->csensor.data[0] * rad_to_deg;
             float y = event->csensor.data[1] * rad_to_deg;
             float z = event->csensor.data[2] * rad_to_deg;
+            std::lock_guard lock{ InputState.cur_controllers_mutex };
             ControllerState& state = InputState.controller_states[event->csensor.which];
             uint64_t cur_timestamp = event->csensor.timestamp;
             uint32_t delta_ms = cur_timestamp - state.prev_gyro_timestamp;
@@ -268,19 +356,15 @@ bool sdl_event_filter(void* userdata, SDL_Event* event) {
             float rot_y = 0.0f;
             state.motion.GetPlayerSpaceGyro(rot_x, rot_y);
 
-            {
-                std::lock_guard lock{ InputState.pending_input_mutex };
-                InputState.pending_rotation_delta[0] += rot_x;
-                InputState.pending_rotation_delta[1] += rot_y;
-            }
+            InputState.total_rotation[0].store(InputState.total_rotation[0].load() + rot_x);
+            InputState.total_rotation[1].store(InputState.total_rotation[1].load() + rot_y);
         }
         break;
     case SDL_EventType::SDL_MOUSEMOTION:
         if (!dino::input::game_input_disabled()) {
             SDL_MouseMotionEvent* motion_event = &event->motion;
-            std::lock_guard lock{ InputState.pending_input_mutex };
-            InputState.pending_mouse_delta[0] += motion_event->xrel;
-            InputState.pending_mouse_delta[1] += motion_event->yrel;
+            InputState.total_mouse_motion[0].store(InputState.total_mouse_motion[0].load() + motion_event->xrel);
+            InputState.total_mouse_motion[1].store(InputState.total_mouse_motion[1].load() + motion_event->yrel);
         }
         queue_if_enabled(event);
         break;
@@ -473,33 +557,121 @@ const dino::input::DefaultN64Mappings dino::input::default_n64_controller_mappin
     }
 };
 
-void dino::input::poll_inputs() {
-    InputState.keys = SDL_GetKeyboardState(&InputState.numkeys);
-    InputState.keymod = SDL_GetModState();
+static void capture_input_snapshot(InputSnapshot& snapshot) {
+    snapshot.sample_time = ultramodern::time_since_start();
+    snapshot.digital_sources.fill(0);
+    snapshot.controller_half_axes.fill(0.0f);
 
-    {
-        std::lock_guard lock{ InputState.cur_controllers_mutex };
-        InputState.cur_controllers.clear();
+    int numkeys = 0;
+    const Uint8* keys = SDL_GetKeyboardState(&numkeys);
+    SDL_Keymod keymod = SDL_GetModState();
+    for (int key = 0; key < std::min(numkeys, int(SDL_NUM_SCANCODES)); key++) {
+        if (keys[key] != 0 && !should_override_keystate(static_cast<SDL_Scancode>(key), keymod)) {
+            set_source_bit(snapshot.digital_sources, key_source_start + key);
+        }
+    }
 
-        for (const auto& [id, state] : InputState.controller_states) {
-            (void)id; // Avoid unused variable warning.
-            SDL_GameController* controller = state.controller;
-            if (controller != nullptr) {
-                InputState.cur_controllers.push_back(controller);
+    for (const auto& controller : InputState.cur_controllers) {
+        for (size_t button = 0; button < SDL_CONTROLLER_BUTTON_MAX; button++) {
+            if (SDL_GameControllerGetButton(controller, (SDL_GameControllerButton)button)) {
+                set_source_bit(snapshot.digital_sources, button_source_start + button);
             }
         }
+
+        for (size_t axis = 0; axis < SDL_CONTROLLER_AXIS_MAX; axis++) {
+            float cur_val = SDL_GameControllerGetAxis(controller, (SDL_GameControllerAxis)axis) * (1/32768.0f);
+            snapshot.controller_half_axes[get_half_axis_index((SDL_GameControllerAxis)axis, false)] += std::clamp(cur_val, 0.0f, 1.0f);
+            snapshot.controller_half_axes[get_half_axis_index((SDL_GameControllerAxis)axis, true)] += std::clamp(-cur_val, 0.0f, 1.0f);
+        }
     }
 
-    // Read the deltas while resetting them to zero.
-    {
-        std::lock_guard lock{ InputState.pending_input_mutex };
-        
-        InputState.rotation_delta = InputState.pending_rotation_delta;
-        InputState.pending_rotation_delta = { 0.0f, 0.0f };
+    for (size_t half_axis = 0; half_axis < half_axis_count; half_axis++) {
+        float& value = snapshot.controller_half_axes[half_axis];
+        value = std::clamp(value, 0.0f, 1.0f);
+        // TODO adjustable threshold
+        if (value >= axis_threshold) {
+            set_source_bit(snapshot.digital_sources, half_axis_source_start + half_axis);
+        }
+    }
+
+    for (size_t i = 0; i < 2; i++) {
+        snapshot.total_rotation[i] = InputState.total_rotation[i].load();
+        snapshot.total_mouse_motion[i] = InputState.total_mouse_motion[i].load();
+    }
+}
+
+// Takes a snapshot of the current input state and publishes it.
+static void sample_inputs() {
+    std::lock_guard lock{ InputState.cur_controllers_mutex };
+    InputState.cur_controllers.clear();
+
+    for (const auto& [id, state] : InputState.controller_states) {
+        (void)id; // Avoid unused variable warning.
+        SDL_GameController* controller = state.controller;
+        if (controller != nullptr) {
+            InputState.cur_controllers.push_back(controller);
+        }
+    }
+
+    capture_input_snapshot(input_snapshots[back_snapshot]);
+
+    // Publish the new snapshot, taking the previous ready one as the next back snapshot.
+    back_snapshot = ready_snapshot.exchange(back_snapshot | snapshot_new_bit) & snapshot_index_mask;
+}
+
+static void sampling_thread_func(int rate) {
+    std::chrono::steady_clock::duration interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / rate));
+    std::chrono::steady_clock::time_point next_sample = std::chrono::steady_clock::now();
+    while (InputState.sampling_thread_running) {
+        sample_inputs();
+
+        // Skip samples that were missed instead of trying to catch up on them.
+        next_sample = std::max(next_sample + interval, std::chrono::steady_clock::now());
+        std::this_thread::sleep_until(next_sample);
+    }
+}
+
+void dino::input::set_input_sampling_rate(int rate) {
+    rate = (rate > 0) ? std::clamp(rate, 100, 1000) : 0;
+    if (rate == InputState.sampling_rate) {
+        return;
+    }
+
+    if (InputState.sampling_thread.joinable()) {
+        InputState.sampling_thread_running = false;
+        InputState.sampling_thread.join();
+    }
+
+    InputState.sampling_rate = rate;
+    if (rate > 0) {
+        InputState.sampling_thread_running = true;
+        InputState.sampling_thread = std::thread{ sampling_thread_func, rate };
+    }
+}
+
+int dino::input::get_input_sampling_rate() {
+    return InputState.sampling_rate;
+}
+
+std::chrono::nanoseconds dino::input::get_input_sample_time() {
+    return input_snapshots[front_snapshot].sample_time;
+}
+
+void dino::input::poll_inputs() {
+    // The sampling thread already keeps the snapshots fresh when it's running.
+    if (!InputState.sampling_thread_running) {
+        sample_inputs();
+    }
 
-        InputState.mouse_delta = InputState.pending_mouse_delta;
-        InputState.pending_mouse_delta = { 0.0f, 0.0f };
+    // Take the deltas since the last poll.
+    acquire_input_snapshot();
+    const InputSnapshot& snapshot = input_snapshots[front_snapshot];
+    for (size_t i = 0; i < 2; i++) {
+        InputState.rotation_delta[i] = float(snapshot.total_rotation[i] - InputState.polled_total_rotation[i]);
+        InputState.mouse_delta[i] = float(snapshot.total_mouse_motion[i] - InputState.polled_total_mouse_motion[i]);
     }
+    InputState.polled_total_rotation = snapshot.total_rotation;
+    InputState.polled_total_mouse_motion = snapshot.total_mouse_motion;
 }
 
 void dino::input::set_rumble(int controller_num, bool on) {
@@ -551,111 +723,113 @@ void dino::input::update_rumble() {
     }
 }
 
-bool controller_button_state(int32_t input_id) {
-    if (input_id >= 0 && input_id < SDL_GameControllerButton::SDL_CONTROLLER_BUTTON_MAX) {
-        SDL_GameControllerButton button = (SDL_GameControllerButton)input_id;
-        bool ret = false;
-        {
-            std::lock_guard lock{ InputState.cur_controllers_mutex };
-            for (const auto& controller : InputState.cur_controllers) {
-                ret |= SDL_GameControllerGetButton(controller, button);
-            }
-        }
-
-        return ret;
+void dino::input::acquire_input_snapshot() {
+    if ((ready_snapshot.load() & snapshot_new_bit) != 0) {
+        front_snapshot = ready_snapshot.exchange(front_snapshot) & snapshot_index_mask;
     }
-    return false;
 }
 
 static std::atomic_bool right_analog_suppressed = false;
 
-float controller_axis_state(int32_t input_id, bool allow_suppression) {
-    if (abs(input_id) - 1 < SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_MAX) {
-        SDL_GameControllerAxis axis = (SDL_GameControllerAxis)(abs(input_id) - 1);
-        bool negative_range = input_id < 0;
-        float ret = 0.0f;
-
-        {
-            std::lock_guard lock{ InputState.cur_controllers_mutex };
-            for (const auto& controller : InputState.cur_controllers) {
-                float cur_val = SDL_GameControllerGetAxis(controller, axis) * (1/32768.0f);
-                if (negative_range) {
-                    cur_val = -cur_val;
-                }
-
-                // Check if this input is a right analog axis and suppress it accordingly.
-                if (allow_suppression && right_analog_suppressed.load() &&
-                    (axis == SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_RIGHTX || axis == SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_RIGHTY)) {
-                    cur_val = 0;
-                }
-                ret += std::clamp(cur_val, 0.0f, 1.0f);
-            }
+static float controller_axis_state(int32_t input_id, bool allow_suppression) {
+    const InputSnapshot& snapshot = input_snapshots[front_snapshot];
+    int32_t axis = abs(input_id) - 1;
+    if (axis >= 0 && axis < SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_MAX) {
+        // Check if this input is a right analog axis and suppress it accordingly.
+        if (allow_suppression && right_analog_suppressed.load() &&
+            (axis == SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_RIGHTX || axis == SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_RIGHTY)) {
+            return 0.0f;
         }
 
-        return std::clamp(ret, 0.0f, 1.0f);
+        return snapshot.controller_half_axes[get_half_axis_index((SDL_GameControllerAxis)axis, input_id < 0)];
     }
-    return false;
+    return 0.0f;
 }
 
-float dino::input::get_input_analog(const dino::input::InputField& field) {
+// Returns the input source that a field reads from, or -1 if it isn't bound to a supported one.
+static int32_t get_input_source(const dino::input::InputField& field) {
     switch ((InputType)field.input_type) {
     case InputType::Keyboard:
-        if (InputState.keys && field.input_id >= 0 && field.input_id < InputState.numkeys) {
-            if (should_override_keystate(static_cast<SDL_Scancode>(field.input_id), InputState.keymod)) {
-                return 0.0f;
-            }
-            return InputState.keys[field.input_id] ? 1.0f : 0.0f;
+        if (field.input_id >= 0 && field.input_id < SDL_NUM_SCANCODES) {
+            return int32_t(key_source_start + field.input_id);
         }
-        return 0.0f;
+        return -1;
     case InputType::ControllerDigital:
-        return controller_button_state(field.input_id) ? 1.0f : 0.0f;
-    case InputType::ControllerAnalog:
-        return controller_axis_state(field.input_id, true);
+        if (field.input_id >= 0 && field.input_id < SDL_GameControllerButton::SDL_CONTROLLER_BUTTON_MAX) {
+            return int32_t(button_source_start + field.input_id);
+        }
+        return -1;
+    case InputType::ControllerAnalog: {
+        int32_t axis = abs(field.input_id) - 1;
+        if (axis >= 0 && axis < SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_MAX) {
+            return int32_t(half_axis_source_start + get_half_axis_index((SDL_GameControllerAxis)axis, field.input_id < 0));
+        }
+        return -1;
+    }
     case InputType::Mouse:
         // TODO mouse support
-        return 0.0f;
+        return -1;
     case InputType::None:
-        return false;
+        return -1;
     }
+    return -1;
 }
 
-float dino::input::get_input_analog(const std::span<const dino::input::InputField> fields) {
-    float ret = 0.0f;
+dino::input::CompiledBinding dino::input::compile_binding(const std::span<const dino::input::InputField> fields) {
+    CompiledBinding ret{};
+    ret.half_axes.fill(-1);
+
+    size_t half_axis_slot = 0;
     for (const auto& field : fields) {
-        ret += get_input_analog(field);
+        int32_t source = get_input_source(field);
+        if (source < 0) {
+            continue;
+        }
+
+        set_source_bit(ret.digital_sources, size_t(source));
+        if (size_t(source) >= half_axis_source_start && half_axis_slot < ret.half_axes.size()) {
+            ret.half_axes[half_axis_slot++] = int32_t(source - half_axis_source_start);
+        }
     }
-    return std::clamp(ret, 0.0f, 1.0f);
+
+    return ret;
 }
 
-bool dino::input::get_input_digital(const dino::input::InputField& field) {
-    switch ((InputType)field.input_type) {
-    case InputType::Keyboard:
-        if (InputState.keys && field.input_id >= 0 && field.input_id < InputState.numkeys) {
-            if (should_override_keystate(static_cast<SDL_Scancode>(field.input_id), InputState.keymod)) {
-                return false;
-            }
-            return InputState.keys[field.input_id] != 0;
+bool dino::input::get_input_digital(const dino::input::CompiledBinding& binding) {
+    const InputSnapshot& snapshot = input_snapshots[front_snapshot];
+    const InputSourceMask& suppressed = right_analog_suppressed.load() ? right_analog_sources : no_sources;
+    return any_source_bits(snapshot.digital_sources, binding.digital_sources, suppressed);
+}
+
+float dino::input::get_input_analog(const dino::input::CompiledBinding& binding) {
+    const InputSnapshot& snapshot = input_snapshots[front_snapshot];
+
+    // Keys and buttons count as fully pressed, axes contribute their value.
+    float ret = any_source_bits(snapshot.digital_sources, binding.digital_sources, all_half_axis_sources) ? 1.0f : 0.0f;
+    bool suppressed = right_analog_suppressed.load();
+    for (int32_t half_axis : binding.half_axes) {
+        if (half_axis >= 0 && !(suppressed && test_source_bit(right_analog_sources, half_axis_source_start + half_axis))) {
+            ret += snapshot.controller_half_axes[half_axis];
         }
-        return false;
-    case InputType::ControllerDigital:
-        return controller_button_state(field.input_id);
-    case InputType::ControllerAnalog:
-        // TODO adjustable threshold
-        return controller_axis_state(field.input_id, true) >= axis_threshold;
-    case InputType::Mouse:
-        // TODO mouse support
-        return false;
-    case InputType::None:
-        return false;
     }
+
+    return std::clamp(ret, 0.0f, 1.0f);
+}
+
+float dino::input::get_input_analog(const dino::input::InputField& field) {
+    return get_input_analog(compile_binding({ &field, 1 }));
+}
+
+float dino::input::get_input_analog(const std::span<const dino::input::InputField> fields) {
+    return get_input_analog(compile_binding(fields));
+}
+
+bool dino::input::get_input_digital(const dino::input::InputField& field) {
+    return get_input_digital(compile_binding({ &field, 1 }));
 }
 
 bool dino::input::get_input_digital(const std::span<const dino::input::InputField> fields) {
-    bool ret = 0;
-    for (const auto& field : fields) {
-        ret |= get_input_digital(field);
-    }
-    return ret;
+    return get_input_digital(compile_binding(fields));
 }
 
 void dino::input::get_gyro_deltas(float* x, float* y) {
@@ -708,6 +882,7 @@ void dino::input::apply_joystick_deadzone(float x_in, float y_in, float* x_out,
 }
 
 void dino::input::get_right_analog(float* x, float* y) {
+    dino::input::acquire_input_snapshot();
     float x_val =
         controller_axis_state((SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_RIGHTX + 1), false) -
         controller_axis_state(-(SDL_GameControllerAxis::SDL_CONTROLLER_AXIS_RIGHTX + 1), false);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <chrono>
 #include <cstdint>
 #include <vector>
 #include <span>
@@ -66,6 +68,15 @@ namespace dino::input {
     };
 
     void poll_inputs();
+    // Switches get_input_analog/get_input_digital over to the newest snapshot taken by poll_inputs.
+    // Must only be called from the thread that reads input.
+    void acquire_input_snapshot();
+    // When the snapshot in use was captured, relative to ultramodern's start time.
+    std::chrono::nanoseconds get_input_sample_time();
+    // Rate in Hz of the thread that samples input in the background so the game reads the freshest state when it
+    // resolves its inputs. 0 disables the thread, in which case input is only sampled when the game polls.
+    void set_input_sampling_rate(int rate);
+    int get_input_sampling_rate();
     float get_input_analog(const InputField& field);
     float get_input_analog(const std::span<const InputField> fields);
     bool get_input_digital(const InputField& field);
@@ -149,6 +160,22 @@ namespace dino::input {
 
     constexpr size_t bindings_per_input = 2;
 
+    // Enough 64-bit words for one bit per key, controller button and controller half axis.
+    constexpr size_t input_source_mask_words = 9;
+
+    // The bindings of an input compiled into masks, so resolving them against the current input snapshot takes the
+    // same few bitwise operations no matter what they're bound to.
+    struct CompiledBinding {
+        // Input sources that activate the input.
+        std::array<uint64_t, input_source_mask_words> digital_sources{};
+        // Half axes that add their analog value to the input, or -1. Only the first bindings_per_input are kept.
+        std::array<int32_t, bindings_per_input> half_axes{};
+    };
+
+    CompiledBinding compile_binding(const std::span<const InputField> fields);
+    float get_input_analog(const CompiledBinding& binding);
+    bool get_input_digital(const CompiledBinding& binding);
+
     void set_rumble(int controller_num, bool);
     void update_rumble();
     void handle_events();
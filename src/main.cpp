@@ -196,6 +196,9 @@ int main(int argc, char** argv) {
         threads_callbacks
     );
 
+    // Stop the input sampling thread if it was enabled.
+    dino::input::set_input_sampling_rate(0);
+
     NFD_Quit();
 
     if (preloaded) {
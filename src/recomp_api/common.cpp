@@ -1,18 +1,123 @@
 #include "common.hpp"
 
+#include <cstring>
+
+#include "frame_arena.hpp"
+
 namespace dino::recomp_api {
-    char *copy_rdram_str(PTR(char) str, uint8_t* rdram, recomp_context* ctx) {
-        u32 len = 0;
-        PTR(char) str_ptr = str;
-        while (MEM_B(0, (gpr)str_ptr++) != '\0') {
+    // Strings longer than this are heap allocated instead of taking up space in the frame arena.
+    static constexpr size_t max_arena_str_size = 0x1000;
+
+    static inline uint32_t *rdram_word(uint8_t* rdram, gpr addr) {
+        return reinterpret_cast<uint32_t*>(rdram + (addr - 0xFFFFFFFF80000000ULL));
+    }
+
+    static inline uint32_t byteswap32(uint32_t val) {
+        return ((val & 0x000000FF) << 24) |
+               ((val & 0x0000FF00) << 8) |
+               ((val & 0x00FF0000) >> 8) |
+               ((val & 0xFF000000) >> 24);
+    }
+
+    size_t rdram_strlen(uint8_t* rdram, gpr str) {
+        size_t len = 0;
+
+        // Walk byte by byte until the address is word aligned.
+        while (((str + len) & 3) != 0) {
+            if (MEM_B(len, str) == '\0') {
+                return len;
+            }
             len++;
         }
 
-        char *copy = (char*)malloc(len + 1);
-        for (size_t i = 0; i <= len; i++) {
-            copy[i] = MEM_B(i, (gpr)str);
+        // Check a whole word at a time for a zero byte. Words are native-endian, so the first byte
+        // in memory order is the most significant byte of the loaded value.
+        while (true) {
+            uint32_t word = *rdram_word(rdram, str + len);
+            if (((word - 0x01010101U) & ~word & 0x80808080U) != 0) {
+                for (int shift = 24; shift >= 0; shift -= 8) {
+                    if (((word >> shift) & 0xFF) == 0) {
+                        return len;
+                    }
+                    len++;
+                }
+            }
+            len += 4;
+        }
+    }
+
+    void copy_from_rdram(uint8_t* rdram, void* dst, gpr src, size_t len) {
+        uint8_t *out = reinterpret_cast<uint8_t*>(dst);
+
+        while (len > 0 && (src & 3) != 0) {
+            *out++ = MEM_B(0, src);
+            src++;
+            len--;
+        }
+
+        while (len >= 4) {
+            uint32_t word = byteswap32(*rdram_word(rdram, src));
+            memcpy(out, &word, sizeof(word));
+            out += 4;
+            src += 4;
+            len -= 4;
+        }
+
+        while (len > 0) {
+            *out++ = MEM_B(0, src);
+            src++;
+            len--;
         }
+    }
+
+    void copy_to_rdram(uint8_t* rdram, gpr dst, const void* src, size_t len) {
+        const uint8_t *in = reinterpret_cast<const uint8_t*>(src);
+
+        while (len > 0 && (dst & 3) != 0) {
+            MEM_B(0, dst) = *in++;
+            dst++;
+            len--;
+        }
+
+        while (len >= 4) {
+            uint32_t word;
+            memcpy(&word, in, sizeof(word));
+            *rdram_word(rdram, dst) = byteswap32(word);
+            in += 4;
+            dst += 4;
+            len -= 4;
+        }
+
+        while (len > 0) {
+            MEM_B(0, dst) = *in++;
+            dst++;
+            len--;
+        }
+    }
+
+    RdramStr read_rdram_str(uint8_t* rdram, PTR(char) str) {
+        if ((gpr)str == 0) {
+            return RdramStr{};
+        }
+
+        size_t len = rdram_strlen(rdram, (gpr)str);
+
+        if (len < max_arena_str_size) {
+            char *data = FrameArena::current().alloc_array<char>(len + 1);
+            if (data != nullptr) {
+                copy_from_rdram(rdram, data, (gpr)str, len);
+                data[len] = '\0';
+
+                return RdramStr{ data, len };
+            }
+        }
+
+        // Too long for the arena or the arena is out of space.
+        std::unique_ptr<char[]> owned = std::make_unique<char[]>(len + 1);
+        copy_from_rdram(rdram, owned.get(), (gpr)str, len);
+        owned[len] = '\0';
 
-        return copy;
+        const char *data = owned.get();
+        return RdramStr{ data, len, std::move(owned) };
     }
 }
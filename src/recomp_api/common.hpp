@@ -1,12 +1,49 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
 #include "librecomp/overlays.hpp" // IWYU pragma: export
 #include "librecomp/helpers.hpp"
 
 #define REGISTER_EXPORT(name) recomp::overlays::register_base_export(#name, name)
 
 namespace dino::recomp_api {
+    // RDRAM is stored as native-endian 32-bit words, so the byte at address A actually lives at A ^ 3.
+    // These helpers undo that swizzle a whole word at a time and only fall back to per-byte access
+    // for the unaligned head and tail of a range.
+
+    // Returns the length of a null-terminated string in rdram, not including the terminator.
+    size_t rdram_strlen(uint8_t* rdram, gpr str);
+    // Copies len bytes starting at the rdram address src into dst.
+    void copy_from_rdram(uint8_t* rdram, void* dst, gpr src, size_t len);
+    // Copies len bytes from src into rdram starting at the address dst.
+    void copy_to_rdram(uint8_t* rdram, gpr dst, const void* src, size_t len);
+
+    // A null-terminated copy of a string read out of rdram.
+    //
+    // Strings up to a page in length live in the calling thread's FrameArena and are only valid until the
+    // end of the current game tick. Longer strings are heap allocated and owned by this object.
+    // Either way, the string must not be kept beyond the lifetime of this object.
+    class RdramStr {
+    public:
+        RdramStr() = default;
+        RdramStr(const char *str, size_t len, std::unique_ptr<char[]> &&heap_str = nullptr)
+            : data(str), length(len), owned(std::move(heap_str)) {}
+
+        // Returns nullptr if the string was read from a null pointer.
+        const char *c_str() const { return data; }
+        size_t size() const { return length; }
+        std::string_view view() const { return data == nullptr ? std::string_view{} : std::string_view{ data, length }; }
+
+    private:
+        const char *data = nullptr;
+        size_t length = 0;
+        std::unique_ptr<char[]> owned;
+    };
+
     // Strings must be copied out of rdram since their character addresses are effectively
-    // reversed in rdram compared to normal ram. The returned pointer MUST be freed by the caller.
-    char *copy_rdram_str(PTR(char) str, uint8_t* rdram, recomp_context* ctx);
+    // reversed in rdram compared to normal ram. A null str results in a null RdramStr.
+    RdramStr read_rdram_str(uint8_t* rdram, PTR(char) str);
 }
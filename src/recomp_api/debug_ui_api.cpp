@@ -1,5 +1,6 @@
 #include "debug_ui_api.hpp"
 #include "common.hpp"
+#include "frame_arena.hpp"
 
 #include <vector>
 
@@ -9,6 +10,8 @@
 #include "imgui.h"
 
 #include "debug_ui/debug_ui.hpp"
+#include "debug_ui/latency.hpp"
+#include "debug_ui/texture_packs.hpp"
 #include "config/config.hpp"
 #include "common/recomp_helpers.hpp"
 
@@ -32,20 +35,18 @@ extern "C" void dbgui_begin(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) name_ptr = _arg<0, PTR(char)>(rdram, ctx);
     PTR(s32) open_ptr = _arg<1, PTR(s32)>(rdram, ctx);
 
-    char *name = dino::recomp_api::copy_rdram_str(name_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr name = dino::recomp_api::read_rdram_str(rdram, name_ptr);
 
     bool expanded = false;
     if ((gpr)open_ptr != 0) {
         bool open = MEM_W(0, (gpr)open_ptr) != 0;
-        expanded = dino::debug_ui::begin(name, &open);
+        expanded = dino::debug_ui::begin(name.c_str(), &open);
 
         MEM_W(0, (gpr)open_ptr) = open;
     } else {
-        expanded = dino::debug_ui::begin(name, nullptr);
+        expanded = dino::debug_ui::begin(name.c_str(), nullptr);
     }
 
-    free(name);
-
     _return<s32>(ctx, expanded);
 }
 
@@ -56,24 +57,19 @@ extern "C" void dbgui_end(uint8_t* rdram, recomp_context* ctx) {
 extern "C" void dbgui_text(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) text_ptr = _arg<0, PTR(char)>(rdram, ctx);
 
-    char *text = dino::recomp_api::copy_rdram_str(text_ptr, rdram, ctx);
-
-    dino::debug_ui::text(text);
+    dino::recomp_api::RdramStr text = dino::recomp_api::read_rdram_str(rdram, text_ptr);
 
-    free(text);
+    dino::debug_ui::text(text.c_str());
 }
 
 extern "C" void dbgui_label_text(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
     PTR(char) text_ptr = _arg<1, PTR(char)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
-    char *text = dino::recomp_api::copy_rdram_str(text_ptr, rdram, ctx);
-
-    dino::debug_ui::label_text(label, text);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
+    dino::recomp_api::RdramStr text = dino::recomp_api::read_rdram_str(rdram, text_ptr);
 
-    free(label);
-    free(text);
+    dino::debug_ui::label_text(label.c_str(), text.c_str());
 }
 
 extern "C" void dbgui_same_line(uint8_t* rdram, recomp_context* ctx) {
@@ -92,13 +88,10 @@ extern "C" void dbgui_begin_combo(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
     PTR(char) preview_ptr = _arg<1, PTR(char)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
-    char *preview = dino::recomp_api::copy_rdram_str(preview_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
+    dino::recomp_api::RdramStr preview = dino::recomp_api::read_rdram_str(rdram, preview_ptr);
 
-    bool open = dino::debug_ui::begin_combo(label, preview);
-
-    free(label);
-    free(preview);
+    bool open = dino::debug_ui::begin_combo(label.c_str(), preview.c_str());
 
     _return<s32>(ctx, open);
 }
@@ -111,11 +104,9 @@ extern "C" void dbgui_selectable(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
     bool selected = _arg<1, s32>(rdram, ctx) != 0;
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
-
-    bool pressed = dino::debug_ui::selectable(label, &selected);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
-    free(label);
+    bool pressed = dino::debug_ui::selectable(label.c_str(), &selected);
 
     _return<s32>(ctx, pressed);
 }
@@ -123,11 +114,9 @@ extern "C" void dbgui_selectable(uint8_t* rdram, recomp_context* ctx) {
 extern "C" void dbgui_button(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
-    bool pressed = dino::debug_ui::button(label);
-
-    free(label);
+    bool pressed = dino::debug_ui::button(label.c_str());
 
     _return<s32>(ctx, pressed);
 }
@@ -145,11 +134,9 @@ extern "C" void dbgui_end_main_menu_bar(uint8_t* rdram, recomp_context* ctx) {
 extern "C" void dbgui_begin_menu(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
-
-    bool open = dino::debug_ui::begin_menu(label);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
-    free(label);
+    bool open = dino::debug_ui::begin_menu(label.c_str());
 
     _return<s32>(ctx, open);
 }
@@ -162,31 +149,27 @@ extern "C" void dbgui_menu_item(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
     PTR(s32) selected_ptr = _arg<1, PTR(s32)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
     bool pressed = false;
     if ((gpr)selected_ptr != 0) {
         bool selected = MEM_W(0, (gpr)selected_ptr) != 0;
-        pressed = dino::debug_ui::menu_item(label, &selected);
+        pressed = dino::debug_ui::menu_item(label.c_str(), &selected);
 
         MEM_W(0, (gpr)selected_ptr) = selected;
     } else {
-        pressed = dino::debug_ui::menu_item(label, nullptr);
+        pressed = dino::debug_ui::menu_item(label.c_str(), nullptr);
     }
 
-    free(label);
-
     _return<s32>(ctx, pressed);
 }
 
 extern "C" void dbgui_collapsing_header(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
-    bool open = dino::debug_ui::collapsing_header(label);
-
-    free(label);
+    bool open = dino::debug_ui::collapsing_header(label.c_str());
 
     _return<s32>(ctx, open);
 }
@@ -194,11 +177,9 @@ extern "C" void dbgui_collapsing_header(uint8_t* rdram, recomp_context* ctx) {
 extern "C" void dbgui_tree_node(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
-
-    bool open = dino::debug_ui::tree_node(label);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
-    free(label);
+    bool open = dino::debug_ui::tree_node(label.c_str());
 
     _return<s32>(ctx, open);
 }
@@ -210,11 +191,9 @@ extern "C" void dbgui_tree_pop(uint8_t* rdram, recomp_context* ctx) {
 extern "C" void dbgui_begin_child(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) str_id_ptr = _arg<0, PTR(char)>(rdram, ctx);
 
-    char *str_id = dino::recomp_api::copy_rdram_str(str_id_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr str_id = dino::recomp_api::read_rdram_str(rdram, str_id_ptr);
 
-    bool open = dino::debug_ui::begin_child(str_id);
-
-    free(str_id);
+    bool open = dino::debug_ui::begin_child(str_id.c_str());
 
     _return<s32>(ctx, open);
 }
@@ -227,16 +206,14 @@ extern "C" void dbgui_checkbox(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
     PTR(s32) value_ptr = _arg<1, PTR(s32)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
     bool value = MEM_W(0, (gpr)value_ptr) != 0;
 
-    bool pressed = dino::debug_ui::checkbox(label, &value);
+    bool pressed = dino::debug_ui::checkbox(label.c_str(), &value);
 
     MEM_W(0, (gpr)value_ptr) = value;
 
-    free(label);
-
     _return<s32>(ctx, pressed);
 }
 
@@ -244,16 +221,14 @@ extern "C" void dbgui_input_int(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
     PTR(s32) value_ptr = _arg<1, PTR(s32)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
     s32 value = MEM_W(0, (gpr)value_ptr);
 
-    bool pressed = dino::debug_ui::input_int(label, &value);
+    bool pressed = dino::debug_ui::input_int(label.c_str(), &value);
 
     MEM_W(0, (gpr)value_ptr) = value;
 
-    free(label);
-
     _return<s32>(ctx, pressed);
 }
 
@@ -262,7 +237,7 @@ extern "C" void dbgui_input_int_ext(uint8_t* rdram, recomp_context* ctx) {
     PTR(s32) value_ptr = _arg<1, PTR(s32)>(rdram, ctx);
     PTR(void) options_ptr = _arg<2, PTR(void)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
     s32 value = MEM_W(0, (gpr)value_ptr);
 
@@ -270,12 +245,10 @@ extern "C" void dbgui_input_int_ext(uint8_t* rdram, recomp_context* ctx) {
     int step_fast = MEM_W(0x4, options_ptr);
     int flags = MEM_W(0x8, options_ptr);
 
-    bool pressed = dino::debug_ui::input_int_ext(label, &value, step, step_fast, flags);
+    bool pressed = dino::debug_ui::input_int_ext(label.c_str(), &value, step, step_fast, flags);
 
     MEM_W(0, (gpr)value_ptr) = value;
 
-    free(label);
-
     _return<s32>(ctx, pressed);
 }
 
@@ -283,11 +256,9 @@ extern "C" void dbgui_input_float(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
     float *value_ptr = _arg<1, float*>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
-
-    bool pressed = dino::debug_ui::input_float(label, value_ptr);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
-    free(label);
+    bool pressed = dino::debug_ui::input_float(label.c_str(), value_ptr);
 
     _return<s32>(ctx, pressed);
 }
@@ -297,49 +268,47 @@ extern "C" void dbgui_input_float_ext(uint8_t* rdram, recomp_context* ctx) {
     float *value_ptr = _arg<1, float*>(rdram, ctx);
     PTR(void) options_ptr = _arg<2, PTR(void)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
     float step = MEM_F32(0x0, options_ptr);
     float step_fast = MEM_F32(0x4, options_ptr);
     PTR(char) format_ptr = MEM_W(0x8, options_ptr);
     int flags = MEM_W(0xC, options_ptr);
 
-    char *format = format_ptr == NULL ? nullptr : dino::recomp_api::copy_rdram_str(format_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr format = dino::recomp_api::read_rdram_str(rdram, format_ptr);
 
-    bool pressed = dino::debug_ui::input_float_ext(label, value_ptr, step, step_fast, format, flags);
-
-    free(label);
-    if (format != nullptr) {
-        free(format);
-    }
+    bool pressed = dino::debug_ui::input_float_ext(label.c_str(), value_ptr, step, step_fast, format.c_str(), flags);
 
     _return<s32>(ctx, pressed);
 }
 
-static std::vector<char> text_input_buffer{};
+// Returns a scratch buffer for ImGui to edit a copy of an rdram text buffer in place.
+static char *get_text_input_buffer(u32 buf_size, std::vector<char> &heap_fallback) {
+    char *buf = dino::recomp_api::FrameArena::current().alloc_array<char>(buf_size);
+    if (buf == nullptr) {
+        heap_fallback.resize(buf_size);
+        buf = heap_fallback.data();
+    }
+    return buf;
+}
 
 extern "C" void dbgui_input_text(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
     PTR(char) buf_ptr = _arg<1, PTR(char)>(rdram, ctx);
     u32 buf_size = _arg<2, u32>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
-    text_input_buffer.resize(buf_size);
-    for (size_t i = 0; i < buf_size; i++) {
-        text_input_buffer.data()[i] = MEM_B(i, (gpr)buf_ptr);
-    }
+    std::vector<char> heap_fallback{};
+    char *buffer = get_text_input_buffer(buf_size, heap_fallback);
+    dino::recomp_api::copy_from_rdram(rdram, buffer, (gpr)buf_ptr, buf_size);
 
-    bool changed = dino::debug_ui::input_text(label, text_input_buffer.data(), buf_size);
+    bool changed = dino::debug_ui::input_text(label.c_str(), buffer, buf_size);
 
     if (changed) {
-        for (size_t i = 0; i < buf_size; i++) {
-            MEM_B(i, (gpr)buf_ptr) = text_input_buffer.data()[i];
-        }
+        dino::recomp_api::copy_to_rdram(rdram, (gpr)buf_ptr, buffer, buf_size);
     }
 
-    free(label);
-
     _return<s32>(ctx, changed);
 }
 
@@ -349,23 +318,18 @@ extern "C" void dbgui_input_text_ext(uint8_t* rdram, recomp_context* ctx) {
     u32 buf_size = _arg<2, u32>(rdram, ctx);
     u32 flags = _arg<3, u32>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
-    text_input_buffer.resize(buf_size);
-    for (size_t i = 0; i < buf_size; i++) {
-        text_input_buffer.data()[i] = MEM_B(i, (gpr)buf_ptr);
-    }
+    std::vector<char> heap_fallback{};
+    char *buffer = get_text_input_buffer(buf_size, heap_fallback);
+    dino::recomp_api::copy_from_rdram(rdram, buffer, (gpr)buf_ptr, buf_size);
 
-    bool changed = dino::debug_ui::input_text_ext(label, text_input_buffer.data(), buf_size, flags);
+    bool changed = dino::debug_ui::input_text_ext(label.c_str(), buffer, buf_size, flags);
 
     if (changed) {
-        for (size_t i = 0; i < buf_size; i++) {
-            MEM_B(i, (gpr)buf_ptr) = text_input_buffer.data()[i];
-        }
+        dino::recomp_api::copy_to_rdram(rdram, (gpr)buf_ptr, buffer, buf_size);
     }
 
-    free(label);
-
     _return<s32>(ctx, changed);
 }
 
@@ -388,11 +352,9 @@ extern "C" void dbgui_pop_item_width(uint8_t* rdram, recomp_context* ctx) {
 extern "C" void dbgui_begin_tab_bar(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) id_ptr = _arg<0, PTR(char)>(rdram, ctx);
 
-    char *id = dino::recomp_api::copy_rdram_str(id_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr id = dino::recomp_api::read_rdram_str(rdram, id_ptr);
 
-    bool active = dino::debug_ui::begin_tab_bar(id);
-
-    free(id);
+    bool active = dino::debug_ui::begin_tab_bar(id.c_str());
 
     _return<s32>(ctx, active);
 }
@@ -405,20 +367,18 @@ extern "C" void dbgui_begin_tab_item(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) label_ptr = _arg<0, PTR(char)>(rdram, ctx);
     PTR(s32) open_ptr = _arg<1, PTR(s32)>(rdram, ctx);
 
-    char *label = dino::recomp_api::copy_rdram_str(label_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr label = dino::recomp_api::read_rdram_str(rdram, label_ptr);
 
     bool active = false;
     if ((gpr)open_ptr != 0) {
         bool open = MEM_W(0, (gpr)open_ptr) != 0;
-        active = dino::debug_ui::begin_tab_item(label, &open);
+        active = dino::debug_ui::begin_tab_item(label.c_str(), &open);
 
         MEM_W(0, (gpr)open_ptr) = open;
     } else {
-        active = dino::debug_ui::begin_tab_item(label, nullptr);
+        active = dino::debug_ui::begin_tab_item(label.c_str(), nullptr);
     }
 
-    free(label);
-
     _return<s32>(ctx, active);
 }
 
@@ -429,11 +389,9 @@ extern "C" void dbgui_end_tab_item(uint8_t* rdram, recomp_context* ctx) {
 extern "C" void dbgui_push_str_id(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) id_ptr = _arg<0, PTR(char)>(rdram, ctx);
 
-    char *id = dino::recomp_api::copy_rdram_str(id_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr id = dino::recomp_api::read_rdram_str(rdram, id_ptr);
 
-    dino::debug_ui::push_str_id(id);
-
-    free(id);
+    dino::debug_ui::push_str_id(id.c_str());
 }
 
 extern "C" void dbgui_pop_id(uint8_t* rdram, recomp_context* ctx) {
@@ -481,11 +439,9 @@ extern "C" void dbgui_foreground_text(uint8_t* rdram, recomp_context* ctx) {
         MEM_F32(0x4, pos_ptr)
     );
 
-    char *text = dino::recomp_api::copy_rdram_str(text_ptr, rdram, ctx);
-
-    dino::debug_ui::foreground_text(pos, color, text);
+    dino::recomp_api::RdramStr text = dino::recomp_api::read_rdram_str(rdram, text_ptr);
 
-    free(text);
+    dino::debug_ui::foreground_text(pos, color, text.c_str());
 }
 
 extern "C" void dbgui_foreground_line(uint8_t* rdram, recomp_context* ctx) {
@@ -600,6 +556,31 @@ extern "C" void dbgui_foreground_rect_filled(uint8_t* rdram, recomp_context* ctx
     dino::debug_ui::foreground_rect_filled(pmin, pmax, color);
 }
 
+extern "C" void dbgui_begin_throttled(uint8_t* rdram, recomp_context* ctx) {
+    PTR(char) id_ptr = _arg<0, PTR(char)>(rdram, ctx);
+    s32 interval = _arg<1, s32>(rdram, ctx);
+
+    dino::recomp_api::RdramStr id = dino::recomp_api::read_rdram_str(rdram, id_ptr);
+
+    _return<s32>(ctx, dino::debug_ui::begin_throttled(id.c_str(), interval));
+}
+
+extern "C" void dbgui_end_throttled(uint8_t* rdram, recomp_context* ctx) {
+    dino::debug_ui::end_throttled();
+}
+
+extern "C" void dbgui_throttle_menu(uint8_t* rdram, recomp_context* ctx) {
+    dino::debug_ui::throttle_menu();
+}
+
+extern "C" void dbgui_latency_tab(uint8_t* rdram, recomp_context* ctx) {
+    dino::debug_ui::latency_tab();
+}
+
+extern "C" void dbgui_texture_packs_tab(uint8_t* rdram, recomp_context* ctx) {
+    dino::debug_ui::texture_packs_tab();
+}
+
 namespace dino::recomp_api {
     void register_debug_ui_exports() {
         REGISTER_EXPORT(dbgui_is_open);
@@ -652,5 +633,10 @@ namespace dino::recomp_api {
         REGISTER_EXPORT(dbgui_foreground_ellipse_filled);
         REGISTER_EXPORT(dbgui_foreground_rect);
         REGISTER_EXPORT(dbgui_foreground_rect_filled);
+        REGISTER_EXPORT(dbgui_begin_throttled);
+        REGISTER_EXPORT(dbgui_end_throttled);
+        REGISTER_EXPORT(dbgui_throttle_menu);
+        REGISTER_EXPORT(dbgui_latency_tab);
+        REGISTER_EXPORT(dbgui_texture_packs_tab);
     }
 }
@@ -0,0 +1,72 @@
+#include "frame_arena.hpp"
+
+#include <algorithm>
+
+namespace dino::recomp_api {
+    static constexpr size_t block_size = 0x10000;
+    // Upper bound on how much a single thread's arena may reserve.
+    static constexpr size_t max_reserved_size = 0x400000;
+
+    FrameArena &FrameArena::current() {
+        static thread_local FrameArena arena{};
+        return arena;
+    }
+
+    void *FrameArena::alloc(size_t size, size_t alignment) {
+        while (true) {
+            if (cur_block < blocks.size()) {
+                Block &block = blocks[cur_block];
+                uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+                uintptr_t start = (base + cur_offset + (alignment - 1)) & ~(uintptr_t)(alignment - 1);
+                size_t end_offset = (start - base) + size;
+
+                if (end_offset <= block.size) {
+                    bytes_used += end_offset - cur_offset;
+                    cur_offset = end_offset;
+                    return reinterpret_cast<void*>(start);
+                }
+
+                // Doesn't fit in what's left of this block, move on to the next one.
+                cur_block++;
+                cur_offset = 0;
+                continue;
+            }
+
+            if (!add_block(size + alignment)) {
+                return nullptr;
+            }
+        }
+    }
+
+    void FrameArena::reset() {
+        // If the last frame needed more than one block, replace them with a single block that fits the whole
+        // frame so that subsequent frames don't have to hop between blocks.
+        if (blocks.size() > 1) {
+            size_t total_size = get_bytes_reserved();
+            blocks.clear();
+            blocks.push_back(Block{ std::make_unique<uint8_t[]>(total_size), total_size });
+        }
+
+        cur_block = 0;
+        cur_offset = 0;
+        bytes_used = 0;
+    }
+
+    size_t FrameArena::get_bytes_reserved() const {
+        size_t total = 0;
+        for (const Block &block : blocks) {
+            total += block.size;
+        }
+        return total;
+    }
+
+    bool FrameArena::add_block(size_t min_size) {
+        size_t size = std::max(block_size, min_size);
+        if (get_bytes_reserved() + size > max_reserved_size) {
+            return false;
+        }
+
+        blocks.push_back(Block{ std::make_unique<uint8_t[]>(size), size });
+        return true;
+    }
+}
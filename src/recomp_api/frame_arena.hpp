@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace dino::recomp_api {
+    // Thread-local bump allocator for native-side temporaries that only need to live until the end of the current
+    // game tick. The game thread resets its arena from game_tick_end_hook. Memory is kept between resets, so once
+    // the arena has grown to fit a typical tick no further heap allocations are made.
+    class FrameArena {
+    public:
+        // Returns the calling thread's arena.
+        static FrameArena &current();
+
+        // Returns nullptr if the arena is out of capacity, in which case the caller should fall back to the heap.
+        // Threads that never reach game_tick_end_hook will eventually hit this.
+        void *alloc(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template <typename T>
+        T *alloc_array(size_t count) {
+            return static_cast<T*>(alloc(sizeof(T) * count, alignof(T)));
+        }
+
+        // Releases everything allocated from this arena. Any pointers previously returned become invalid.
+        void reset();
+
+        size_t get_bytes_used() const { return bytes_used; }
+        size_t get_bytes_reserved() const;
+    private:
+        struct Block {
+            std::unique_ptr<uint8_t[]> data;
+            size_t size;
+        };
+
+        std::vector<Block> blocks;
+        size_t cur_block = 0;
+        size_t cur_offset = 0;
+        size_t bytes_used = 0;
+
+        bool add_block(size_t min_size);
+    };
+}
@@ -6,6 +6,7 @@
 
 #include "ui/recomp_ui.h"
 #include "common.hpp"
+#include "frame_arena.hpp"
 
 extern "C" void recomp_get_window_resolution(uint8_t* rdram, recomp_context* ctx) {
     int width, height;
@@ -67,21 +68,17 @@ extern "C" void recomp_get_refresh_rate(uint8_t* rdram, recomp_context* ctx) {
 extern "C" void recomp_error_message_box(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) message_ptr = _arg<0, PTR(char)>(rdram, ctx);
 
-    char *message = dino::recomp_api::copy_rdram_str(message_ptr, rdram, ctx);
+    dino::recomp_api::RdramStr message = dino::recomp_api::read_rdram_str(rdram, message_ptr);
 
-    ultramodern::error_handling::message_box(message);
-
-    free(message);
+    ultramodern::error_handling::message_box(message.c_str());
 }
 
 extern "C" void recomp_exit_with_error(uint8_t* rdram, recomp_context* ctx) {
     PTR(char) message_ptr = _arg<0, PTR(char)>(rdram, ctx);
 
-    char *message = dino::recomp_api::copy_rdram_str(message_ptr, rdram, ctx);
-
-    ultramodern::error_handling::message_box(message);
+    dino::recomp_api::RdramStr message = dino::recomp_api::read_rdram_str(rdram, message_ptr);
 
-    free(message);
+    ultramodern::error_handling::message_box(message.c_str());
 
     ultramodern::error_handling::quick_exit(__FILE__, __LINE__, __FUNCTION__);
 }
@@ -97,6 +94,10 @@ extern "C" void recomp_powf(uint8_t* rdram, recomp_context* ctx) {
     _return(ctx, std::pow(a, b));
 }
 
+extern "C" void recomp_reset_frame_arena(uint8_t* rdram, recomp_context* ctx) {
+    dino::recomp_api::FrameArena::current().reset();
+}
+
 extern "C" void recomp_time_us(uint8_t* rdram, recomp_context* ctx) {
     _return(ctx, static_cast<u32>(std::chrono::duration_cast<std::chrono::microseconds>(ultramodern::time_since_start()).count()));
 }
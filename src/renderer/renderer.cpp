@@ -2,7 +2,9 @@
 #include "hle/rt64_application.h"
 #include "renderer.hpp"
 
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <variant>
 
 #include "ultramodern/config.hpp"
@@ -10,8 +12,10 @@
 #include "common/overloaded.h"
 #include "debug_ui/debug_ui.hpp"
 #include "debug_ui/backend.hpp"
+#include "debug_ui/latency.hpp"
 #include "ui/recomp_ui.h"
 #include "concurrentqueue.h"
+#include "lightweightsemaphore.h"
 
 static RT64::UserConfiguration::Antialiasing device_max_msaa = RT64::UserConfiguration::Antialiasing::None;
 static bool sample_positions_supported = false;
@@ -42,6 +46,13 @@ struct TexturePackUpdateAction {
 using TexturePackAction = std::variant<TexturePackEnableAction, TexturePackDisableAction, TexturePackSecondaryEnableAction, TexturePackSecondaryDisableAction, TexturePackUpdateAction>;
 
 static moodycamel::ConcurrentQueue<TexturePackAction> texture_pack_action_queue;
+static moodycamel::LightweightSemaphore texture_pack_action_signal;
+// Texture pack actions arrive in bursts, e.g. every enabled pack is enabled one by one when the mods are loaded.
+// The texture pack thread is only woken up at the next display list, so a whole burst is applied with one load.
+static std::atomic_bool texture_pack_actions_queued = false;
+
+static std::mutex texture_pack_stats_mutex;
+static dino::renderer::TexturePackStats texture_pack_stats;
 
 // Note: These must be outside of a namespace, N64ModernRuntime references them as global externs
 unsigned int MI_INTR_REG = 0;
@@ -329,12 +340,20 @@ RT64Context::RT64Context(uint8_t* rdram, ultramodern::renderer::WindowHandle win
     }
 
     high_precision_fb_enabled = app->shaderLibrary->usesHDR;
+
+    texture_pack_thread_running = true;
+    texture_pack_thread = std::thread(&RT64Context::texture_pack_thread_func, this);
 }
 
-RT64Context::~RT64Context() = default;
+RT64Context::~RT64Context() {
+    stop_texture_pack_thread();
+}
 
 void RT64Context::send_dl(const OSTask* task) {
-    check_texture_pack_actions();
+    dino::debug_ui::latency_display_list_sent();
+    if (texture_pack_actions_queued.load(std::memory_order_relaxed) && texture_pack_actions_queued.exchange(false)) {
+        texture_pack_action_signal.signal();
+    }
     app->state->rsp->reset();
     app->interpreter->loadUCodeGBI(task->t.ucode & 0x3FFFFFF, task->t.ucode_data & 0x3FFFFFF, true);
     app->processDisplayLists(app->core.RDRAM, task->t.data_ptr & 0x3FFFFFF, 0, true);
@@ -344,9 +363,13 @@ void RT64Context::update_screen(uint32_t vi_origin) {
     VI_ORIGIN_REG = vi_origin;
 
     app->updateScreen();
+
+    dino::debug_ui::latency_screen_presented();
 }
 
 void RT64Context::shutdown() {
+    stop_texture_pack_thread();
+
     if (app != nullptr) {
         app->end();
     }
@@ -400,6 +423,27 @@ float RT64Context::get_resolution_scale() const {
     }
 }
 
+void RT64Context::texture_pack_thread_func() {
+    while (true) {
+        texture_pack_action_signal.wait();
+        if (!texture_pack_thread_running) {
+            break;
+        }
+
+        // RT64's texture cache guards its replacements internally, so loading them here doesn't need to be
+        // synchronized with display lists being processed.
+        check_texture_pack_actions();
+    }
+}
+
+void RT64Context::stop_texture_pack_thread() {
+    if (texture_pack_thread.joinable()) {
+        texture_pack_thread_running = false;
+        texture_pack_action_signal.signal();
+        texture_pack_thread.join();
+    }
+}
+
 void RT64Context::check_texture_pack_actions() {
     bool packs_changed = false;
     TexturePackAction cur_action;
@@ -427,36 +471,77 @@ void RT64Context::check_texture_pack_actions() {
         }, cur_action);
     }
 
-    // If any packs were disabled, unload all packs and load all the active ones.
-    if (packs_changed) {
-        // Sort the enabled texture packs in reverse order so that earlier ones override later ones.
-        std::vector<std::string> sorted_texture_packs{};
-        sorted_texture_packs.reserve(enabled_texture_packs.size());
-        for (const std::string& mod : enabled_texture_packs) {
-            if (!secondary_disabled_texture_packs.contains(mod)) {
-                sorted_texture_packs.emplace_back(mod);
-            }
-        }
-
-        std::sort(sorted_texture_packs.begin(), sorted_texture_packs.end(),
-            [](const std::string& lhs, const std::string& rhs) {
-                return recomp::mods::get_mod_order_index(lhs) > recomp::mods::get_mod_order_index(rhs);
-            }
-        );
+    if (!packs_changed) {
+        return;
+    }
 
-        // Build the path list from the sorted mod list.
-        std::vector<RT64::ReplacementDirectory> replacement_directories;
-        replacement_directories.reserve(enabled_texture_packs.size());
-        for (const std::string &mod_id : sorted_texture_packs) {
-            replacement_directories.emplace_back(RT64::ReplacementDirectory(recomp::mods::get_mod_filename(mod_id)));
+    // Sort the enabled texture packs in reverse order so that earlier ones override later ones.
+    std::vector<std::string> sorted_texture_packs{};
+    sorted_texture_packs.reserve(enabled_texture_packs.size());
+    for (const std::string& mod : enabled_texture_packs) {
+        if (!secondary_disabled_texture_packs.contains(mod)) {
+            sorted_texture_packs.emplace_back(mod);
         }
+    }
 
-        if (!replacement_directories.empty()) {
-            app->textureCache->loadReplacementDirectories(replacement_directories);
-        }
-        else {
-            app->textureCache->clearReplacementDirectories();
+    std::sort(sorted_texture_packs.begin(), sorted_texture_packs.end(),
+        [](const std::string& lhs, const std::string& rhs) {
+            return recomp::mods::get_mod_order_index(lhs) > recomp::mods::get_mod_order_index(rhs);
         }
+    );
+
+    std::vector<LoadedTexturePack> texture_packs;
+    texture_packs.reserve(sorted_texture_packs.size());
+    for (const std::string &mod_id : sorted_texture_packs) {
+        LoadedTexturePack &texture_pack = texture_packs.emplace_back();
+        std::error_code ec;
+        texture_pack.mod_id = mod_id;
+        texture_pack.path = recomp::mods::get_mod_filename(mod_id);
+        texture_pack.file_size = std::filesystem::is_regular_file(texture_pack.path, ec) ? std::filesystem::file_size(texture_pack.path, ec) : 0;
+        texture_pack.write_time = std::filesystem::last_write_time(texture_pack.path, ec);
+    }
+
+    // Actions often cancel each other out or don't affect texture packs at all (e.g. reordering other mods, or
+    // a pack being disabled and enabled again while the mod list is refreshed). Reloading the replacements is
+    // expensive for large packs, so only do it when the set of packs or their priority actually changed.
+    if (texture_packs == loaded_texture_packs) {
+        std::lock_guard lock{ texture_pack_stats_mutex };
+        texture_pack_stats.skipped_load_count++;
+        return;
+    }
+
+    loaded_texture_packs = std::move(texture_packs);
+
+    // Build the path list from the sorted mod list.
+    std::vector<RT64::ReplacementDirectory> replacement_directories;
+    replacement_directories.reserve(loaded_texture_packs.size());
+    for (const LoadedTexturePack &texture_pack : loaded_texture_packs) {
+        replacement_directories.emplace_back(RT64::ReplacementDirectory(texture_pack.path));
+    }
+
+    {
+        std::lock_guard lock{ texture_pack_stats_mutex };
+        texture_pack_stats.loading = true;
+    }
+
+    auto load_start = std::chrono::high_resolution_clock::now();
+    if (!replacement_directories.empty()) {
+        app->textureCache->loadReplacementDirectories(replacement_directories);
+    }
+    else {
+        app->textureCache->clearReplacementDirectories();
+    }
+
+    std::chrono::nanoseconds load_time = std::chrono::high_resolution_clock::now() - load_start;
+
+    std::lock_guard lock{ texture_pack_stats_mutex };
+    texture_pack_stats.loading = false;
+    texture_pack_stats.load_count++;
+    texture_pack_stats.last_load_time = load_time;
+    texture_pack_stats.total_load_time += load_time;
+    texture_pack_stats.loaded_packs.clear();
+    for (auto it = loaded_texture_packs.rbegin(); it != loaded_texture_packs.rend(); it++) {
+        texture_pack_stats.loaded_packs.emplace_back(TexturePackStats::Pack{ it->mod_id, it->path, it->file_size });
     }
 }
 
@@ -476,12 +561,22 @@ bool RT64HighPrecisionFBEnabled() {
     return high_precision_fb_enabled;
 }
 
+TexturePackStats get_texture_pack_stats() {
+    std::lock_guard lock{ texture_pack_stats_mutex };
+    return texture_pack_stats;
+}
+
+static void queue_texture_pack_action(TexturePackAction &&action) {
+    texture_pack_action_queue.enqueue(std::move(action));
+    texture_pack_actions_queued = true;
+}
+
 void trigger_texture_pack_update() {
-    texture_pack_action_queue.enqueue(TexturePackUpdateAction{});
+    queue_texture_pack_action(TexturePackUpdateAction{});
 }
 
 void enable_texture_pack(const recomp::mods::ModContext& context, const recomp::mods::ModHandle& mod) {
-    texture_pack_action_queue.enqueue(TexturePackEnableAction{mod.manifest.mod_id});
+    queue_texture_pack_action(TexturePackEnableAction{mod.manifest.mod_id});
 
     // Check for the texture pack enabled config option.
     const recomp::mods::ConfigSchema& config_schema = context.get_mod_config_schema(mod.manifest.mod_id);
@@ -510,15 +605,15 @@ void enable_texture_pack(const recomp::mods::ModContext& context, const recomp::
 }
 
 void disable_texture_pack(const recomp::mods::ModHandle& mod) {
-    texture_pack_action_queue.enqueue(TexturePackDisableAction{mod.manifest.mod_id});
+    queue_texture_pack_action(TexturePackDisableAction{mod.manifest.mod_id});
 }
 
 void secondary_enable_texture_pack(const std::string& mod_id) {
-    texture_pack_action_queue.enqueue(TexturePackSecondaryEnableAction{mod_id});
+    queue_texture_pack_action(TexturePackSecondaryEnableAction{mod_id});
 }
 
 void secondary_disable_texture_pack(const std::string& mod_id) {
-    texture_pack_action_queue.enqueue(TexturePackSecondaryDisableAction{mod_id});
+    queue_texture_pack_action(TexturePackSecondaryDisableAction{mod_id});
 }
 
 
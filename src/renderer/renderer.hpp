@@ -1,7 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <unordered_set>
 #include <filesystem>
+#include <thread>
+#include <vector>
 
 #include "common/rt64_user_configuration.h"
 #include "ultramodern/renderer_context.hpp"
@@ -31,10 +35,29 @@ namespace dino::renderer {
         float get_resolution_scale() const override;
 
     private:
+        // Identifies the contents of a texture pack that was handed to RT64, so a pack that is replaced on disk
+        // gets reloaded even if its path stays the same.
+        struct LoadedTexturePack {
+            std::string mod_id;
+            std::filesystem::path path;
+            uintmax_t file_size;
+            std::filesystem::file_time_type write_time;
+
+            bool operator==(const LoadedTexturePack &rhs) const = default;
+        };
+
         std::unique_ptr<RT64::Application> app;
         std::unordered_set<std::string> enabled_texture_packs;
         std::unordered_set<std::string> secondary_disabled_texture_packs;
+        // Texture packs currently loaded into RT64's texture cache, in the order they were passed to it.
+        std::vector<LoadedTexturePack> loaded_texture_packs;
+        // Texture packs are loaded on their own thread so that display list submission never waits on them. The
+        // texture pack state above is only accessed by this thread.
+        std::thread texture_pack_thread;
+        std::atomic_bool texture_pack_thread_running = false;
 
+        void texture_pack_thread_func();
+        void stop_texture_pack_thread();
         void check_texture_pack_actions();
     };
 
@@ -50,6 +73,25 @@ namespace dino::renderer {
     void secondary_enable_texture_pack(const std::string& mod_id);
     void secondary_disable_texture_pack(const std::string& mod_id);
 
+    struct TexturePackStats {
+        struct Pack {
+            std::string mod_id;
+            std::filesystem::path path;
+            uintmax_t file_size;
+        };
+
+        // Packs loaded into RT64, in the same order as the mod list.
+        std::vector<Pack> loaded_packs;
+        bool loading = false;
+        uint64_t load_count = 0;
+        // Changes to the texture pack state that didn't require the packs to be loaded again.
+        uint64_t skipped_load_count = 0;
+        std::chrono::nanoseconds last_load_time{};
+        std::chrono::nanoseconds total_load_time{};
+    };
+
+    TexturePackStats get_texture_pack_stats();
+
     // Texture pack enable option. Must be an enum with two options.
     // The first option is treated as disabled and the second option is treated as enabled.
     bool is_texture_pack_enable_config_option(const recomp::mods::ConfigOption& option, bool show_errors);
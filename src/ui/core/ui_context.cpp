@@ -1,3 +1,4 @@
+#include <map>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -37,9 +38,13 @@ namespace recompui {
         Element* autofocus_element = nullptr;
         std::vector<Element*> loose_elements;
         std::unordered_set<ResourceId> to_update;
-        std::vector<std::tuple<Element*, ResourceId, std::string>> to_set_text;     
+        std::vector<std::tuple<Element*, ResourceId, std::string>> to_set_text;
+        // Element properties set since the last update, keyed by element and property so repeated sets only keep the last value.
+        std::map<std::pair<Element*, Rml::PropertyId>, std::pair<ResourceId, Rml::Property>> to_set_property;     
         bool captures_input = true;
         bool captures_mouse = true;
+        // Set whenever the context is closed, since whoever had it open may have modified it. Guarded by context_lock.
+        bool modified = false;
         Context(Rml::ElementDocument* document) : document(document), root_element(document) {}
     };
 } // namespace recompui
@@ -70,6 +75,8 @@ enum class ContextErrorType {
     UpdateElementInWrongContext,
     SetTextElementWithoutContext,
     SetTextElementInWrongContext,
+    SetPropertyWithoutContext,
+    SetPropertyInWrongContext,
     GetResourceWithoutOpen,
     GetResourceFailed,
     DestroyResourceWithoutOpen,
@@ -128,6 +135,12 @@ void context_error(recompui::ContextId id, ContextErrorType type) {
         case ContextErrorType::SetTextElementInWrongContext:
             error_message = "Attempted to set the text of a UI element in a different UI context than the one that's open";
             break;
+        case ContextErrorType::SetPropertyWithoutContext:
+            error_message = "Attempted to set a property of a UI resource with no open UI context";
+            break;
+        case ContextErrorType::SetPropertyInWrongContext:
+            error_message = "Attempted to set a property of a UI resource in a different UI context than the one that's open";
+            break;
         case ContextErrorType::GetResourceWithoutOpen:
             error_message = "Attempted to get a UI resource with no open UI context";
             break;
@@ -345,15 +358,20 @@ bool recompui::ContextId::open_if_not_already() {
     return true;
 }
 
-void recompui::ContextId::close() {
+static void close_context(recompui::ContextId id, bool mark_modified) {
     // Ensure a context is currently opened by this thread.
-    if (opened_context_id == ContextId::null()) {
-        context_error(*this, ContextErrorType::CloseWithoutOpen);
+    if (opened_context_id == recompui::ContextId::null()) {
+        context_error(id, ContextErrorType::CloseWithoutOpen);
     }
 
     // Check that the context that was specified is the same one that's currently open.
-    if (*this != opened_context_id) {
-        context_error(*this, ContextErrorType::CloseWrongContext);
+    if (id != opened_context_id) {
+        context_error(id, ContextErrorType::CloseWrongContext);
+    }
+
+    // Flag the context before releasing it, so that whoever opens it next is guaranteed to see the flag.
+    if (mark_modified) {
+        opened_context->modified = true;
     }
 
     // Release ownership of the target context.
@@ -364,10 +382,18 @@ void recompui::ContextId::close() {
     // Remove this context from the opened contexts.
     {
         std::lock_guard lock{ context_state.all_contexts_lock };
-        context_state.opened_contexts.erase(*this);
+        context_state.opened_contexts.erase(id);
     }
 }
 
+void recompui::ContextId::close() {
+    close_context(*this, true);
+}
+
+void recompui::ContextId::close_unmodified() {
+    close_context(*this, false);
+}
+
 recompui::ContextId recompui::try_close_current_context() {
     if (opened_context_id != ContextId::null()) {
         ContextId prev_context = opened_context_id;
@@ -377,7 +403,7 @@ recompui::ContextId recompui::try_close_current_context() {
     return ContextId::null();
 }
 
-void recompui::ContextId::process_updates() {
+bool recompui::ContextId::process_updates() {
     // Ensure a context is currently opened by this thread.
     if (opened_context_id == ContextId::null()) {
         context_error(*this, ContextErrorType::InternalError);
@@ -388,6 +414,29 @@ void recompui::ContextId::process_updates() {
         context_error(*this, ContextErrorType::InternalError);
     }
 
+    // Apply the queued element properties first so that update handlers see them.
+    std::map<std::pair<Element*, Rml::PropertyId>, std::pair<ResourceId, Rml::Property>> to_set_property = std::move(opened_context->to_set_property);
+    opened_context->to_set_property.clear();
+
+    for (const auto& [key, value] : to_set_property) {
+        Element* element_ptr = key.first;
+        ResourceId resource = value.first;
+
+        // Make sure the element still exists, as it may have been deleted after the property was queued.
+        // Elements that aren't resources are the context's root element, which lives as long as the context.
+        if (resource != ResourceId::null()) {
+            std::unique_ptr<Style>* cur_resource = opened_context->resources.get(resource_slotmap::key{ resource.slot_id });
+            if (cur_resource == nullptr || cur_resource->get() != element_ptr) {
+                continue;
+            }
+        }
+        else if (element_ptr != &opened_context->root_element) {
+            continue;
+        }
+
+        element_ptr->set_property(key.second, value.second);
+    }
+
     // Move the current update set into a local variable. This clears the update set
     // and allows it to be used to queue updates from any element callbacks.
     std::unordered_set<ResourceId> to_update = std::move(opened_context->to_update);
@@ -418,6 +467,8 @@ void recompui::ContextId::process_updates() {
     }
 
     std::vector<std::tuple<Element*, ResourceId, std::string>> to_set_text = std::move(opened_context->to_set_text);
+    bool had_updates = opened_context->modified || !to_update.empty() || !to_set_text.empty() || !to_set_property.empty();
+    opened_context->modified = false;
 
     // Delete the Rml elements that are pending deletion.
     for (auto cur_text_update : to_set_text) {
@@ -450,6 +501,8 @@ void recompui::ContextId::process_updates() {
             }
         }
     }
+
+    return had_updates;
 }
 
 bool recompui::ContextId::captures_input() {
@@ -571,6 +624,28 @@ void recompui::ContextId::queue_set_text(Element* element, std::string&& text) {
     opened_context->to_set_text.emplace_back(std::make_tuple(element, element->resource_id, std::move(text)));
 }
 
+void recompui::ContextId::queue_set_property(Style* resource, Rml::PropertyId property_id, const Rml::Property& property) {
+    // Ensure a context is currently opened by this thread.
+    if (opened_context_id == ContextId::null()) {
+        context_error(*this, ContextErrorType::SetPropertyWithoutContext);
+    }
+
+    // Check that the context that was specified is the same one that's currently open.
+    if (*this != opened_context_id) {
+        context_error(*this, ContextErrorType::SetPropertyInWrongContext);
+    }
+
+    // Styles only hold properties until they're applied to an element, so they can be modified immediately.
+    if (!resource->is_element()) {
+        resource->set_property(property_id, property);
+        return;
+    }
+
+    // Element properties are deferred to the update thread, since setting them modifies the underlying Rml element.
+    Element* element = static_cast<Element*>(resource);
+    opened_context->to_set_property.insert_or_assign(std::make_pair(element, property_id), std::make_pair(element->resource_id, property));
+}
+
 recompui::Style* recompui::ContextId::create_style() {
     return add_resource_impl(std::make_unique<Style>());
 }
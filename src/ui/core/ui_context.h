@@ -32,6 +32,7 @@ namespace recompui {
         void add_loose_element(Element* element);
         void queue_element_update(ResourceId element);
         void queue_set_text(Element* element, std::string&& text);
+        void queue_set_property(Style* resource, Rml::PropertyId property_id, const Rml::Property& property);
 
         Style* create_style();
 
@@ -47,7 +48,11 @@ namespace recompui {
         void open();
         bool open_if_not_already();
         void close();
-        void process_updates();
+        // Closes the context without flagging it as modified, for when it was only opened to process its updates.
+        void close_unmodified();
+        // Returns whether any queued element updates or text changes were processed, or the context was closed
+        // (and so may have been modified) since its updates were last processed.
+        bool process_updates();
 
         static constexpr ContextId null() { return ContextId{ .slot_id = uint32_t(-1) }; }
 
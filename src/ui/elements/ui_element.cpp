@@ -103,25 +103,68 @@ void Element::register_event_listeners(uint32_t events_enabled) {
     if (events_enabled & Events(EventType::Navigate)) {
         base->AddEventListener(Rml::EventId::Keydown, this);
     }
+
+    if (events_enabled & Events(EventType::Scroll)) {
+        base->AddEventListener(Rml::EventId::Scroll, this);
+    }
 }
 
-void Element::apply_style(Style *style) {
-    for (auto it : style->property_map) {
-        // Skip redundant SetProperty calls to prevent dirtying unnecessary state.
-        // This avoids expensive layout operations when a simple color-only style is applied.
-        const Rml::Property* cur_value = base->GetLocalProperty(it.first);
-        if (*cur_value != it.second) {
-            base->SetProperty(it.first, it.second);
+void Element::collect_dirty_properties(Style *style, bool style_enabled, uint64_t &applied_version, Rml::PropertyIdSet &dirty_properties) {
+    uint64_t target_version = style_enabled ? style->version : 0;
+    if (applied_version == target_version) {
+        return;
+    }
+
+    // If the style was enabled or disabled, all of its properties are affected. Otherwise only the ones that changed since the last apply.
+    bool toggled = applied_version == 0 || target_version == 0;
+    for (const auto &it : style->property_map) {
+        if (toggled || it.second.version > applied_version) {
+            dirty_properties.Insert(it.first);
         }
     }
+
+    applied_version = target_version;
+}
+
+// Returns the value from the last enabled style that sets the property, falling back to the element's own properties.
+const Rml::Property *Element::resolve_property(Rml::PropertyId property_id) {
+    for (size_t i = styles.size(); i > 0; i--) {
+        if (styles_counter[i - 1] == 0) {
+            auto it = styles[i - 1]->property_map.find(property_id);
+            if (it != styles[i - 1]->property_map.end()) {
+                return &it->second.value;
+            }
+        }
+    }
+
+    auto it = property_map.find(property_id);
+    if (it != property_map.end()) {
+        return &it->second.value;
+    }
+
+    return nullptr;
 }
 
 void Element::apply_styles() {
-    apply_style(this);
+    Rml::PropertyIdSet dirty_properties;
+    collect_dirty_properties(this, true, own_applied_version, dirty_properties);
 
     for (size_t i = 0; i < styles_counter.size(); i++) {
-        if (styles_counter[i] == 0) {
-            apply_style(styles[i]);
+        collect_dirty_properties(styles[i], styles_counter[i] == 0, styles_applied_version[i], dirty_properties);
+    }
+
+    for (Rml::PropertyId property_id : dirty_properties) {
+        // Properties no longer set by any enabled style keep their current value.
+        const Rml::Property *value = resolve_property(property_id);
+        if (value == nullptr) {
+            continue;
+        }
+
+        // Skip redundant SetProperty calls to prevent dirtying unnecessary state.
+        // This avoids expensive layout operations when a simple color-only style is applied.
+        const Rml::Property* cur_value = base->GetLocalProperty(property_id);
+        if (cur_value == nullptr || *cur_value != *value) {
+            base->SetProperty(property_id, *value);
         }
     }
 }
@@ -250,6 +293,9 @@ void Element::ProcessEvent(Rml::Event &event) {
         case Rml::EventId::Dragend:
             handle_event(Event::drag_event(event.GetParameter("mouse_x", 0.0f), event.GetParameter("mouse_y", 0.0f), DragPhase::End));
             break;
+        case Rml::EventId::Scroll:
+            handle_event(Event::scroll_event());
+            break;
         case Rml::EventId::Change: {
             if (events_enabled & Events(EventType::Text)) {
                 Rml::Variant *value_variant = base->GetAttribute("value");
@@ -343,6 +389,7 @@ void Element::add_style(Style *style, const std::initializer_list<std::string_vi
     }
 
     styles_counter.push_back(initial_style_counter);
+    styles_applied_version.push_back(0);
 }
 
 void Element::set_enabled(bool enabled) {
@@ -457,6 +504,20 @@ float Element::get_client_height() {
     return base->GetClientHeight();
 }
 
+float Element::get_scroll_top() {
+    return base->GetScrollTop();
+}
+
+float Element::get_dp_ratio() {
+    Rml::Context *context = base->GetContext();
+    return context != nullptr ? context->GetDensityIndependentPixelRatio() : 1.0f;
+}
+
+float Element::get_viewport_height() {
+    Rml::Context *context = base->GetContext();
+    return context != nullptr ? float(context->GetDimensions().y) : 0.0f;
+}
+
 uint32_t Element::get_input_value_u32() {
     ElementValue value = get_element_value();
     
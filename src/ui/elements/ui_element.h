@@ -1,5 +1,7 @@
 #pragma once
 
+#include "RmlUi/Core/PropertyIdSet.h"
+
 #include "ui_style.h"
 #include "../core/ui_context.h"
 
@@ -29,6 +31,9 @@ private:
     uint32_t events_enabled = 0;
     std::vector<Style *> styles;
     std::vector<uint32_t> styles_counter;
+    // Version of each style as of the last apply_styles, or 0 if the style wasn't enabled then.
+    std::vector<uint64_t> styles_applied_version;
+    uint64_t own_applied_version = 0;
     std::unordered_set<std::string_view> style_active_set;
     std::unordered_multimap<std::string_view, uint32_t> style_name_index_map;
     std::vector<UICallback> callbacks;
@@ -42,7 +47,8 @@ private:
 
     void add_child(Element *child);
     void register_event_listeners(uint32_t events_enabled);
-    void apply_style(Style *style);
+    void collect_dirty_properties(Style *style, bool style_enabled, uint64_t &applied_version, Rml::PropertyIdSet &dirty_properties);
+    const Rml::Property *resolve_property(Rml::PropertyId property_id);
     void propagate_disabled(bool disabled);
     void handle_event(const Event &e);
     void set_id(const std::string& new_id);
@@ -87,6 +93,11 @@ public:
     float get_client_top();
     float get_client_width();
     float get_client_height();
+    float get_scroll_top();
+    // Number of pixels per dp unit.
+    float get_dp_ratio();
+    // Height of the window the element is in, in pixels.
+    float get_viewport_height();
     void enable_focus();
     void focus();
     void blur();
@@ -13,7 +13,7 @@ namespace recompui {
     protected:
         std::string_view get_type_name() override { return "ScrollContainer"; }
     public:
-        ScrollContainer(Element *parent, ScrollDirection direction);
+        ScrollContainer(Element *parent, ScrollDirection direction, uint32_t events_enabled = 0);
     };
 
 } // namespace recompui
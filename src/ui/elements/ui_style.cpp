@@ -187,7 +187,17 @@ namespace recompui {
     }
 
     void Style::set_property(Rml::PropertyId property_id, const Rml::Property &property) {
-        property_map[property_id] = property;
+        auto it = property_map.find(property_id);
+        if (it != property_map.end()) {
+            if (it->second.value == property) {
+                return;
+            }
+
+            it->second = StyleProperty{ property, ++version };
+        }
+        else {
+            property_map.emplace(property_id, StyleProperty{ property, ++version });
+        }
     }
 
     Style::Style() {
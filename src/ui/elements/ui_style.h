@@ -13,7 +13,14 @@ namespace recompui {
         friend class Element; // For access to property_map without making it visible to element subclasses.
         friend class ContextId;
     private:
-        std::map<Rml::PropertyId, Rml::Property> property_map;
+        struct StyleProperty {
+            Rml::Property value;
+            // Value of version when this property was last changed.
+            uint64_t version;
+        };
+        std::map<Rml::PropertyId, StyleProperty> property_map;
+        // Incremented whenever a property changes, so elements can tell which properties changed since they last applied this style.
+        uint64_t version = 0;
     protected:
         virtual void set_property(Rml::PropertyId property_id, const Rml::Property &property);
         ResourceId resource_id = ResourceId::null();
@@ -34,6 +34,7 @@ namespace recompui {
         Update,
         Navigate,
         MouseButton,
+        Scroll,
         Count
     };
 
@@ -175,6 +176,13 @@ namespace recompui {
             e.variant = EventMouseButton{ x, y, button, pressed };
             return e;
         }
+
+        static Event scroll_event() {
+            Event e;
+            e.type = EventType::Scroll;
+            e.variant = std::monostate{};
+            return e;
+        }
     };
 
     enum class Display {
@@ -0,0 +1,251 @@
+#include "ui_virtual_list.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace recompui {
+
+    // Rows within this many rows of the visible area also get elements, so that navigating to a neighboring row
+    // always lands on an existing element.
+    static constexpr uint32_t overscan_rows = 2;
+    // Speed at which rows move into place when a gap is animated, in dp per second.
+    static constexpr float row_animation_speed = 1000.0f;
+
+    VirtualList::VirtualList(Element *parent, float row_height, CreateRowCallback create_row, BindRowCallback bind_row) :
+        ScrollContainer(parent, ScrollDirection::Vertical, Events(EventType::Scroll)),
+        create_row_callback(std::move(create_row)), bind_row_callback(std::move(bind_row)), row_height(row_height) {
+        assert(row_height > 0.0f);
+
+        ContextId context = get_current_context();
+        content = context.create_element<Element>(this);
+        content->set_position(Position::Relative);
+        content->set_width(100.0f, Unit::Percent);
+        content->set_height(0.0f);
+    }
+
+    VirtualList::Row *VirtualList::find_row(uint32_t index) {
+        for (Row &row : rows) {
+            if (row.index == int32_t(index)) {
+                return &row;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void VirtualList::bind_row(Row &row, uint32_t index) {
+        row.index = int32_t(index);
+        row.top = get_row_top(index);
+        row.target_top = row.top;
+        row.element->set_top(row.top);
+        row.element->set_display(row.index == hidden_index ? Display::None : Display::Block);
+        bind_row_callback(row.element, index);
+    }
+
+    float VirtualList::get_row_top(uint32_t index) const {
+        uint32_t slot = index;
+        if (hidden_index >= 0 && index > uint32_t(hidden_index)) {
+            slot--;
+        }
+
+        if (gap_index >= 0 && index >= uint32_t(gap_index)) {
+            slot++;
+        }
+
+        return slot * row_height;
+    }
+
+    void VirtualList::update_visible_rows() {
+        float dp_ratio = get_dp_ratio();
+        float scroll_top = get_scroll_top() / dp_ratio;
+        // The list can't be taller than the window, so a window's worth of rows is always enough to fill it.
+        float viewport_height = get_viewport_height() / dp_ratio;
+
+        uint32_t first_index = uint32_t(std::max(scroll_top / row_height, 0.0f));
+        first_index = first_index > overscan_rows ? first_index - overscan_rows : 0;
+        uint32_t last_index = std::min(count, uint32_t((scroll_top + viewport_height) / row_height) + 1 + overscan_rows);
+
+        auto is_row_wanted = [&](int32_t index) {
+            if (index < 0 || uint32_t(index) >= count) {
+                return false;
+            }
+
+            return (uint32_t(index) >= first_index && uint32_t(index) < last_index) || index == pinned_index || index == hidden_index;
+        };
+
+        // Release the elements of rows that are no longer wanted so they can be reused.
+        for (Row &row : rows) {
+            if (row.index >= 0 && !is_row_wanted(row.index)) {
+                row.index = -1;
+                row.element->set_display(Display::None);
+            }
+        }
+
+        auto bind_if_missing = [&](int32_t index) {
+            if (!is_row_wanted(index) || find_row(uint32_t(index)) != nullptr) {
+                return;
+            }
+
+            auto free_it = std::find_if(rows.begin(), rows.end(), [](const Row &row) { return row.index < 0; });
+            if (free_it == rows.end()) {
+                Element *element = create_row_callback(content);
+                element->set_position(Position::Absolute);
+                element->set_left(0.0f);
+                element->set_width(100.0f, Unit::Percent);
+                rows.emplace_back(Row{ element, -1, 0.0f, 0.0f });
+                free_it = rows.end() - 1;
+            }
+
+            bind_row(*free_it, uint32_t(index));
+        };
+
+        for (uint32_t i = first_index; i < last_index; i++) {
+            bind_if_missing(int32_t(i));
+        }
+
+        bind_if_missing(pinned_index);
+        bind_if_missing(hidden_index);
+    }
+
+    void VirtualList::update_row_positions(bool animate) {
+        for (Row &row : rows) {
+            if (row.index < 0) {
+                continue;
+            }
+
+            row.target_top = get_row_top(uint32_t(row.index));
+            if (!animate) {
+                row.top = row.target_top;
+                row.element->set_top(row.top);
+            }
+        }
+
+        if (animate) {
+            last_animation_time = std::chrono::high_resolution_clock::now();
+            queue_update();
+        }
+    }
+
+    bool VirtualList::animate_rows() {
+        std::chrono::high_resolution_clock::time_point now = std::chrono::high_resolution_clock::now();
+        float delta_time = std::max(std::chrono::duration<float>(now - last_animation_time).count(), 0.0f);
+        float max_distance = row_animation_speed * delta_time;
+        last_animation_time = now;
+
+        bool animating = false;
+        for (Row &row : rows) {
+            if (row.index < 0 || row.top == row.target_top) {
+                continue;
+            }
+
+            row.top += std::clamp(row.target_top - row.top, -max_distance, max_distance);
+            row.element->set_top(row.top);
+            animating |= row.top != row.target_top;
+        }
+
+        return animating;
+    }
+
+    void VirtualList::process_event(const Event &e) {
+        switch (e.type) {
+        case EventType::Scroll:
+            update_visible_rows();
+            break;
+        case EventType::Update:
+            if (animate_rows()) {
+                queue_update();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void VirtualList::set_count(uint32_t count) {
+        this->count = count;
+
+        if (pinned_index >= int32_t(count)) {
+            pinned_index = -1;
+        }
+
+        if (hidden_index >= int32_t(count)) {
+            hidden_index = -1;
+        }
+
+        if (gap_index > int32_t(count)) {
+            gap_index = -1;
+        }
+
+        content->set_height(count * row_height);
+
+        // Every row is bound again since the data behind all of them may have changed.
+        for (Row &row : rows) {
+            row.index = -1;
+            row.element->set_display(Display::None);
+        }
+
+        update_visible_rows();
+    }
+
+    void VirtualList::rebind_rows() {
+        for (Row &row : rows) {
+            if (row.index >= 0) {
+                bind_row(row, uint32_t(row.index));
+            }
+        }
+    }
+
+    Element *VirtualList::get_row(uint32_t index) {
+        Row *row = find_row(index);
+        return row != nullptr ? row->element : nullptr;
+    }
+
+    Element *VirtualList::get_first_row() {
+        Row *first_row = nullptr;
+        for (Row &row : rows) {
+            if (row.index >= 0 && (first_row == nullptr || row.index < first_row->index)) {
+                first_row = &row;
+            }
+        }
+
+        return first_row != nullptr ? first_row->element : nullptr;
+    }
+
+    void VirtualList::set_pinned_index(int32_t index) {
+        pinned_index = index;
+        update_visible_rows();
+    }
+
+    void VirtualList::set_hidden_index(int32_t index) {
+        if (hidden_index >= 0) {
+            Row *row = find_row(uint32_t(hidden_index));
+            if (row != nullptr) {
+                row->element->set_display(Display::Block);
+            }
+        }
+
+        hidden_index = index;
+
+        if (hidden_index >= 0) {
+            Row *row = find_row(uint32_t(hidden_index));
+            if (row != nullptr) {
+                row->element->set_display(Display::None);
+            }
+        }
+
+        update_row_positions(false);
+        update_visible_rows();
+    }
+
+    void VirtualList::set_gap_index(int32_t index, bool animate) {
+        gap_index = index;
+        update_row_positions(animate);
+    }
+
+    uint32_t VirtualList::get_gap_index_at(float y) {
+        float row_height_px = row_height * get_dp_ratio();
+        float offset = (y - content->get_absolute_top()) / row_height_px + 0.5f;
+        return uint32_t(std::clamp(offset, 0.0f, float(count)));
+    }
+
+} // namespace recompui
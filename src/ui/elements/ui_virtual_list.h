@@ -0,0 +1,65 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include "ui_scroll_container.h"
+
+namespace recompui {
+
+    // Vertical scroll container for long lists of rows with the same height. Elements are only created for the rows
+    // that are close to being visible and are recycled for other rows as the list is scrolled.
+    class VirtualList : public ScrollContainer {
+    public:
+        using CreateRowCallback = std::function<Element *(Element *parent)>;
+        using BindRowCallback = std::function<void(Element *row, uint32_t index)>;
+    private:
+        struct Row {
+            Element *element;
+            int32_t index;
+            float top;
+            float target_top;
+        };
+
+        Element *content = nullptr;
+        std::vector<Row> rows;
+        CreateRowCallback create_row_callback;
+        BindRowCallback bind_row_callback;
+        float row_height = 0.0f;
+        uint32_t count = 0;
+        int32_t pinned_index = -1;
+        int32_t hidden_index = -1;
+        int32_t gap_index = -1;
+        std::chrono::high_resolution_clock::time_point last_animation_time;
+
+        Row *find_row(uint32_t index);
+        void bind_row(Row &row, uint32_t index);
+        float get_row_top(uint32_t index) const;
+        void update_visible_rows();
+        void update_row_positions(bool animate);
+        bool animate_rows();
+    protected:
+        void process_event(const Event &e) override;
+        std::string_view get_type_name() override { return "VirtualList"; }
+    public:
+        VirtualList(Element *parent, float row_height, CreateRowCallback create_row, BindRowCallback bind_row);
+        // Changes the number of rows and rebinds every row that has an element.
+        void set_count(uint32_t count);
+        uint32_t get_count() const { return count; }
+        // Calls the bind callback again for every row that has an element, e.g. after the underlying data changed.
+        void rebind_rows();
+        // Returns the element currently showing the row, or nullptr if the row doesn't have one.
+        Element *get_row(uint32_t index);
+        // Returns the element of the lowest row that has one.
+        Element *get_first_row();
+        // Keeps the element of a row alive even when it's scrolled out of view, e.g. because it has focus. -1 for none.
+        void set_pinned_index(int32_t index);
+        // Hides a row and closes the space it takes up. -1 for none.
+        void set_hidden_index(int32_t index);
+        // Opens a space of one row in front of the row at index. -1 for none.
+        void set_gap_index(int32_t index, bool animate);
+        // Returns the index the gap would have to be at to be closest to the given absolute y coordinate in pixels.
+        uint32_t get_gap_index_at(float y);
+    };
+
+} // namespace recompui
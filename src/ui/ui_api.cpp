@@ -28,6 +28,26 @@
 
 using namespace recompui;
 
+// Forwards the properties set on it to the current context's property queue instead of applying them immediately.
+// Mods set properties from the game thread, so deferring them to the UI thread avoids modifying Rml elements while they're
+// being updated or rendered and coalesces repeated sets of the same property into one.
+class QueuedStyle : public Style {
+private:
+    ContextId context;
+    Style* target;
+protected:
+    void set_property(Rml::PropertyId property_id, const Rml::Property &property) override {
+        context.queue_set_property(target, property_id, property);
+    }
+public:
+    QueuedStyle(ContextId context, Style* target) : context(context), target(target) {}
+};
+
+template <int arg_index>
+QueuedStyle arg_queued_style(uint8_t* rdram, recomp_context* ctx) {
+    return QueuedStyle{ recompui::get_current_context(), arg_style<arg_index>(rdram, ctx) };
+}
+
 // Contexts
 void recompui_create_context(uint8_t* rdram, recomp_context* ctx) {
     (void)rdram;
@@ -195,448 +215,448 @@ void recompui_create_slider(uint8_t* rdram, recomp_context* ctx) {
 
 // Position and Layout
 void recompui_set_visibility(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t visibility = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_visibility(static_cast<Visibility>(visibility));
+    resource.set_visibility(static_cast<Visibility>(visibility));
 }
 
 void recompui_set_position(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t position = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_position(static_cast<Position>(position));
+    resource.set_position(static_cast<Position>(position));
 }
 
 void recompui_set_left(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float left = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_left(left, static_cast<Unit>(unit));
+    resource.set_left(left, static_cast<Unit>(unit));
 }
 
 void recompui_set_top(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float top = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_top(top, static_cast<Unit>(unit));
+    resource.set_top(top, static_cast<Unit>(unit));
 }
 
 void recompui_set_right(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float right = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_right(right, static_cast<Unit>(unit));
+    resource.set_right(right, static_cast<Unit>(unit));
 }
 
 void recompui_set_bottom(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float bottom = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_bottom(bottom, static_cast<Unit>(unit));
+    resource.set_bottom(bottom, static_cast<Unit>(unit));
 }
 
 // Sizing
 void recompui_set_width(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float width = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_width(width, static_cast<Unit>(unit));
+    resource.set_width(width, static_cast<Unit>(unit));
 }
 
 void recompui_set_width_auto(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
 
-    resource->set_width_auto();
+    resource.set_width_auto();
 }
 
 void recompui_set_height(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float height = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_height(height, static_cast<Unit>(unit));
+    resource.set_height(height, static_cast<Unit>(unit));
 }
 
 void recompui_set_height_auto(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
 
-    resource->set_height_auto();
+    resource.set_height_auto();
 }
 
 void recompui_set_min_width(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float width = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_min_width(width, static_cast<Unit>(unit));
+    resource.set_min_width(width, static_cast<Unit>(unit));
 }
 
 void recompui_set_min_height(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float height = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_min_height(height, static_cast<Unit>(unit));
+    resource.set_min_height(height, static_cast<Unit>(unit));
 }
 
 void recompui_set_max_width(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float width = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_max_width(width, static_cast<Unit>(unit));
+    resource.set_max_width(width, static_cast<Unit>(unit));
 }
 
 void recompui_set_max_height(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float height = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_max_height(height, static_cast<Unit>(unit));
+    resource.set_max_height(height, static_cast<Unit>(unit));
 }
 
 // Padding
 void recompui_set_padding(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float padding = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_padding(padding, static_cast<Unit>(unit));
+    resource.set_padding(padding, static_cast<Unit>(unit));
 }
 
 void recompui_set_padding_left(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float padding = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_padding_left(padding, static_cast<Unit>(unit));
+    resource.set_padding_left(padding, static_cast<Unit>(unit));
 }
 
 void recompui_set_padding_top(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float padding = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_padding_top(padding, static_cast<Unit>(unit));
+    resource.set_padding_top(padding, static_cast<Unit>(unit));
 }
 
 void recompui_set_padding_right(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float padding = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_padding_right(padding, static_cast<Unit>(unit));
+    resource.set_padding_right(padding, static_cast<Unit>(unit));
 }
 
 void recompui_set_padding_bottom(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float padding = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_padding_bottom(padding, static_cast<Unit>(unit));
+    resource.set_padding_bottom(padding, static_cast<Unit>(unit));
 }
 
 // Margins
 void recompui_set_margin(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float margin = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_margin(margin, static_cast<Unit>(unit));
+    resource.set_margin(margin, static_cast<Unit>(unit));
 }
 
 void recompui_set_margin_left(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float margin = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_margin_left(margin, static_cast<Unit>(unit));
+    resource.set_margin_left(margin, static_cast<Unit>(unit));
 }
 
 void recompui_set_margin_top(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float margin = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_margin_top(margin, static_cast<Unit>(unit));
+    resource.set_margin_top(margin, static_cast<Unit>(unit));
 }
 
 void recompui_set_margin_right(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float margin = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_margin_right(margin, static_cast<Unit>(unit));
+    resource.set_margin_right(margin, static_cast<Unit>(unit));
 }
 
 void recompui_set_margin_bottom(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float margin = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_margin_bottom(margin, static_cast<Unit>(unit));
+    resource.set_margin_bottom(margin, static_cast<Unit>(unit));
 }
 
 void recompui_set_margin_auto(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
 
-    resource->set_margin_auto();
+    resource.set_margin_auto();
 }
 
 void recompui_set_margin_left_auto(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
 
-    resource->set_margin_left_auto();
+    resource.set_margin_left_auto();
 }
 
 void recompui_set_margin_top_auto(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
 
-    resource->set_margin_top_auto();
+    resource.set_margin_top_auto();
 }
 
 void recompui_set_margin_right_auto(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
 
-    resource->set_margin_right_auto();
+    resource.set_margin_right_auto();
 }
 
 void recompui_set_margin_bottom_auto(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
 
-    resource->set_margin_bottom_auto();
+    resource.set_margin_bottom_auto();
 }
 
 // Borders
 void recompui_set_border_width(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float width = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_border_width(width, static_cast<Unit>(unit));
+    resource.set_border_width(width, static_cast<Unit>(unit));
 }
 
 void recompui_set_border_left_width(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float width = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_border_left_width(width, static_cast<Unit>(unit));
+    resource.set_border_left_width(width, static_cast<Unit>(unit));
 }
 
 void recompui_set_border_top_width(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float width = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_border_top_width(width, static_cast<Unit>(unit));
+    resource.set_border_top_width(width, static_cast<Unit>(unit));
 }
 
 void recompui_set_border_right_width(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float width = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_border_right_width(width, static_cast<Unit>(unit));
+    resource.set_border_right_width(width, static_cast<Unit>(unit));
 }
 
 void recompui_set_border_bottom_width(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float width = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_border_bottom_width(width, static_cast<Unit>(unit));
+    resource.set_border_bottom_width(width, static_cast<Unit>(unit));
 }
 
 void recompui_set_border_radius(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float radius = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_border_radius(radius, static_cast<Unit>(unit));
+    resource.set_border_radius(radius, static_cast<Unit>(unit));
 }
 
 void recompui_set_border_top_left_radius(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float radius = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_border_top_left_radius(radius, static_cast<Unit>(unit));
+    resource.set_border_top_left_radius(radius, static_cast<Unit>(unit));
 }
 
 void recompui_set_border_top_right_radius(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float radius = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_border_top_right_radius(radius, static_cast<Unit>(unit));
+    resource.set_border_top_right_radius(radius, static_cast<Unit>(unit));
 }
 
 void recompui_set_border_bottom_left_radius(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float radius = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_border_bottom_left_radius(radius, static_cast<Unit>(unit));
+    resource.set_border_bottom_left_radius(radius, static_cast<Unit>(unit));
 }
 
 void recompui_set_border_bottom_right_radius(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float radius = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_border_bottom_right_radius(radius, static_cast<Unit>(unit));
+    resource.set_border_bottom_right_radius(radius, static_cast<Unit>(unit));
 }
 
 // Colors
 void recompui_set_background_color(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     Color color = arg_color<1>(rdram, ctx);
 
-    resource->set_background_color(color);
+    resource.set_background_color(color);
 }
 
 void recompui_set_border_color(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     Color color = arg_color<1>(rdram, ctx);
 
-    resource->set_border_color(color);
+    resource.set_border_color(color);
 
 }
 
 void recompui_set_border_left_color(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     Color color = arg_color<1>(rdram, ctx);
 
-    resource->set_border_left_color(color);
+    resource.set_border_left_color(color);
 }
 
 void recompui_set_border_top_color(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     Color color = arg_color<1>(rdram, ctx);
 
-    resource->set_border_top_color(color);
+    resource.set_border_top_color(color);
 }
 
 void recompui_set_border_right_color(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     Color color = arg_color<1>(rdram, ctx);
 
-    resource->set_border_right_color(color);
+    resource.set_border_right_color(color);
 }
 
 void recompui_set_border_bottom_color(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     Color color = arg_color<1>(rdram, ctx);
 
-    resource->set_border_bottom_color(color);
+    resource.set_border_bottom_color(color);
 }
 
 void recompui_set_color(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     Color color = arg_color<1>(rdram, ctx);
 
-    resource->set_color(color);
+    resource.set_color(color);
 }
 
 // Cursor and Display
 void recompui_set_cursor(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t cursor = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_cursor(static_cast<Cursor>(cursor));
+    resource.set_cursor(static_cast<Cursor>(cursor));
 }
 
 void recompui_set_opacity(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float opacity = _arg_float_a1(rdram, ctx);
 
-    resource->set_opacity(opacity);
+    resource.set_opacity(opacity);
 }
 
 void recompui_set_display(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t display = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_display(static_cast<Display>(display));
+    resource.set_display(static_cast<Display>(display));
 }
 
 // Flexbox
 void recompui_set_justify_content(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t justify_content = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_justify_content(static_cast<JustifyContent>(justify_content));
+    resource.set_justify_content(static_cast<JustifyContent>(justify_content));
 }
 
 void recompui_set_flex_grow(uint8_t* rdram, recomp_context* ctx) { // float grow
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float grow = _arg_float_a1(rdram, ctx);
 
-    resource->set_flex_grow(grow);
+    resource.set_flex_grow(grow);
 }
 
 void recompui_set_flex_shrink(uint8_t* rdram, recomp_context* ctx) { // float shrink
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float shrink = _arg_float_a1(rdram, ctx);
 
-    resource->set_flex_shrink(shrink);
+    resource.set_flex_shrink(shrink);
 }
 
 void recompui_set_flex_basis_auto(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
 
-    resource->set_flex_basis_auto();
+    resource.set_flex_basis_auto();
 }
 
 void recompui_set_flex_basis(uint8_t* rdram, recomp_context* ctx) { // float basis, Unit unit = Unit::Percent
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float basis = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_flex_basis(basis, static_cast<Unit>(unit));
+    resource.set_flex_basis(basis, static_cast<Unit>(unit));
 }
 
 void recompui_set_flex_direction(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t direction = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_flex_direction(static_cast<FlexDirection>(direction));
+    resource.set_flex_direction(static_cast<FlexDirection>(direction));
 }
 
 void recompui_set_align_items(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t align_items = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_align_items(static_cast<AlignItems>(align_items));
+    resource.set_align_items(static_cast<AlignItems>(align_items));
 }
 
 // Overflow
 void recompui_set_overflow(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t overflow = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_overflow(static_cast<Overflow>(overflow));
+    resource.set_overflow(static_cast<Overflow>(overflow));
 }
 
 void recompui_set_overflow_x(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t overflow = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_overflow_x(static_cast<Overflow>(overflow));
+    resource.set_overflow_x(static_cast<Overflow>(overflow));
 }
 
 void recompui_set_overflow_y(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t overflow = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_overflow_y(static_cast<Overflow>(overflow));
+    resource.set_overflow_y(static_cast<Overflow>(overflow));
 }
 
 // Text and Fonts
@@ -654,89 +674,89 @@ void recompui_set_text(uint8_t* rdram, recomp_context* ctx) {
 }
 
 void recompui_set_font_size(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float size = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_font_size(size, static_cast<Unit>(unit));
+    resource.set_font_size(size, static_cast<Unit>(unit));
 }
 
 void recompui_set_letter_spacing(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float spacing = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_letter_spacing(spacing, static_cast<Unit>(unit));
+    resource.set_letter_spacing(spacing, static_cast<Unit>(unit));
 }
 
 void recompui_set_line_height(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float height = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_line_height(height, static_cast<Unit>(unit));
+    resource.set_line_height(height, static_cast<Unit>(unit));
 }
 
 void recompui_set_font_style(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t style = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_font_style(static_cast<FontStyle>(style));
+    resource.set_font_style(static_cast<FontStyle>(style));
 }
 
 void recompui_set_font_weight(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     int32_t weight = _arg<1, int32_t>(rdram, ctx);
 
-    resource->set_font_weight(weight);
+    resource.set_font_weight(weight);
 }
 
 void recompui_set_text_align(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t text_align = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_text_align(static_cast<TextAlign>(text_align));
+    resource.set_text_align(static_cast<TextAlign>(text_align));
 }
 
 // Gaps
 void recompui_set_gap(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float size = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_gap(size, static_cast<Unit>(unit));
+    resource.set_gap(size, static_cast<Unit>(unit));
 }
 
 void recompui_set_row_gap(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float size = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_row_gap(size, static_cast<Unit>(unit));
+    resource.set_row_gap(size, static_cast<Unit>(unit));
 
 }
 
 void recompui_set_column_gap(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     float size = _arg_float_a1(rdram, ctx);
     uint32_t unit = _arg<2, uint32_t>(rdram, ctx);
 
-    resource->set_column_gap(size, static_cast<Unit>(unit));
+    resource.set_column_gap(size, static_cast<Unit>(unit));
 }
 
 // Drag and Focus
 void recompui_set_drag(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t drag = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_drag(static_cast<Drag>(drag));
+    resource.set_drag(static_cast<Drag>(drag));
 }
 
 void recompui_set_tab_index(uint8_t* rdram, recomp_context* ctx) {
-    Style* resource = arg_style<0>(rdram, ctx);
+    QueuedStyle resource = arg_queued_style<0>(rdram, ctx);
     uint32_t tab_index = _arg<1, uint32_t>(rdram, ctx);
 
-    resource->set_tab_index(static_cast<TabIndex>(tab_index));
+    resource.set_tab_index(static_cast<TabIndex>(tab_index));
 }
 
 // Values
@@ -5,6 +5,7 @@
 #include "librecomp/overlays.hpp"
 #include "librecomp/helpers.hpp"
 #include "ultramodern/error_handling.hpp"
+#include "recomp_api/common.hpp"
 
 #include "ui_helpers.h"
 #include "ui_api_images.h"
@@ -58,9 +59,7 @@ void recompui_create_texture_rgba32(uint8_t* rdram, recomp_context* ctx) {
     swapped_image_bytes.resize(size_bytes);
 
     // Byteswap copy the pixel data.
-    for (size_t i = 0; i < size_bytes; i++) {
-        swapped_image_bytes[i] = MEM_B(i, data_in);
-    }
+    dino::recomp_api::copy_from_rdram(rdram, swapped_image_bytes.data(), (gpr)data_in, size_bytes);
 
     // Create a texture name from the ID and queue its bytes.
     std::string texture_name = get_texture_name(cur_id);
@@ -79,9 +78,7 @@ void recompui_create_texture_image_bytes(uint8_t* rdram, recomp_context* ctx) {
     swapped_image_bytes.resize(size_bytes);
 
     // Byteswap copy the image's data.
-    for (size_t i = 0; i < size_bytes; i++) {
-        swapped_image_bytes[i] = MEM_B(i, data_in);
-    }
+    dino::recomp_api::copy_from_rdram(rdram, swapped_image_bytes.data(), (gpr)data_in, size_bytes);
 
     // Create a texture name from the ID and queue its bytes.
     std::string texture_name = get_texture_name(cur_id);
@@ -3,6 +3,7 @@
 
 #include "librecomp/helpers.hpp"
 #include "librecomp/addresses.hpp"
+#include "recomp_api/common.hpp"
 
 #include "elements/ui_element.h"
 #include "elements/ui_types.h"
@@ -135,17 +136,10 @@ inline void return_string(uint8_t* rdram, recomp_context* ctx, const std::string
 
 inline std::string decode_string(uint8_t* rdram, PTR(char) str) {
     // Get the length of the byteswapped string.
-    size_t len = 0;
-    while (MEM_B(str, len) != 0x00) {
-        len++;
-    }
-
-    std::string ret{};
-    ret.reserve(len + 1);
+    size_t len = dino::recomp_api::rdram_strlen(rdram, (gpr)str);
 
-    for (size_t i = 0; i < len; i++) {
-        ret += (char)MEM_B(str, i);
-    }
+    std::string ret(len, '\0');
+    dino::recomp_api::copy_from_rdram(rdram, ret.data(), (gpr)str, len);
 
     return ret;
 }
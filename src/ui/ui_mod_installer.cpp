@@ -1,5 +1,12 @@
 #include "ui_mod_installer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
 #include "librecomp/mods.hpp"
 
 namespace recompui {
@@ -7,6 +14,13 @@ namespace recompui {
     static const char *TextureDatabaseFilename = "rt64.json";
     static const std::u8string OldExtension = u8".old";
     static const std::u8string NewExtension = u8".new";
+    // Extracted data is gathered into blocks of this size before being written out.
+    static constexpr size_t ZipWriteBufferSize = 4 * 1024 * 1024;
+    static constexpr uint32_t MaxInstallThreads = 4;
+    // Compressed mods in packages up to this size are inflated in memory to validate them before anything is written.
+    static constexpr uint64_t MaxInMemoryProbeSize = 64 * 1024 * 1024;
+    static constexpr uint32_t ZipLocalHeaderSignature = 0x04034b50;
+    static constexpr size_t ZipLocalHeaderSize = 30;
 
     static bool is_dynamic_lib(const std::filesystem::path &file_path) {
 #if defined(_WIN32)
@@ -20,51 +34,302 @@ namespace recompui {
 #endif
     }
 
-    size_t zip_write_func(void *opaque, mz_uint64 offset, const void *bytes, size_t count) {
-        std::ofstream &stream = *(std::ofstream *)(opaque);
-        stream.seekp(offset, std::ios::beg);
-        stream.write((const char *)(bytes), count);
-        return stream.bad() ? 0 : count;
+    // State shared by all the threads of a single call to start_mod_installation.
+    struct InstallationContext {
+        std::function<void(std::filesystem::path, size_t, size_t)> progress_callback;
+        const std::atomic_bool *cancelled = nullptr;
+        std::mutex progress_mutex;
+        std::mutex claimed_paths_mutex;
+        std::unordered_set<std::u8string> claimed_paths;
+
+        bool is_cancelled() const {
+            return cancelled != nullptr && cancelled->load();
+        }
+    };
+
+    // Reserves a target path for the file being installed so two archives being installed at the same time
+    // never write to the same file. Returns false if another archive already provides it.
+    static bool claim_target_path(InstallationContext &context, const std::filesystem::path &target_path) {
+        std::lock_guard lock{ context.claimed_paths_mutex };
+        return context.claimed_paths.emplace(target_path.u8string()).second;
     }
 
-    void start_single_mod_installation(const std::filesystem::path &file_path, recomp::mods::ZipModFileHandle &file_handle, std::function<void(std::filesystem::path, size_t, size_t)> progress_callback, ModInstaller::Result &result) {
-        // Check for the existence of the manifest file.
-        std::filesystem::path mods_directory = recomp::mods::get_mods_directory();
-        std::filesystem::path target_path = mods_directory / file_path.filename();
-        std::filesystem::path target_write_path = target_path.u8string() + NewExtension;
-        ModInstaller::Installation installation;
-        bool exists = false;
-        std::vector<char> manifest_bytes = file_handle.read_file(ManifestFilename, exists);
-        if (exists) {
+    struct ArchiveProgress {
+        InstallationContext &context;
+        const std::filesystem::path &path;
+        size_t total_bytes = 0;
+        size_t processed_bytes = 0;
+        size_t reported_bytes = 0;
+
+        void report() {
+            reported_bytes = processed_bytes;
+            if (context.progress_callback) {
+                std::lock_guard lock{ context.progress_mutex };
+                context.progress_callback(path, processed_bytes, total_bytes);
+            }
+        }
+
+        void advance(size_t bytes) {
+            // Only report progress in steps of 1% to avoid flooding the callback with small chunks.
+            processed_bytes = std::min(processed_bytes + bytes, total_bytes);
+            if ((processed_bytes - reported_bytes >= std::max(total_bytes / 100, size_t(1))) || (processed_bytes == total_bytes)) {
+                report();
+            }
+        }
+    };
+
+    // The reader hands out decompressed data in small chunks in sequential order, so the chunks are gathered into
+    // large blocks and written without seeking.
+    struct ZipWriteStream {
+        std::ofstream stream;
+        std::vector<char> buffer;
+        size_t buffered_bytes = 0;
+        mz_uint64 position = 0;
+        ArchiveProgress &progress;
+
+        ZipWriteStream(const std::filesystem::path &path, ArchiveProgress &progress) : stream(path, std::ios::binary), progress(progress) {}
+
+        bool flush() {
+            if (buffered_bytes > 0) {
+                stream.write(buffer.data(), buffered_bytes);
+                buffered_bytes = 0;
+            }
+
+            return !stream.bad();
+        }
+    };
+
+    static size_t zip_write_func(void *opaque, mz_uint64 offset, const void *bytes, size_t count) {
+        ZipWriteStream &write_stream = *(ZipWriteStream *)(opaque);
+        // Returning a short count makes the reader stop extracting.
+        if (write_stream.progress.context.is_cancelled()) {
+            return 0;
+        }
+
+        if (offset != write_stream.position) {
+            // Not expected from the reader, but keep supporting it in case it ever writes out of order.
+            if (!write_stream.flush()) {
+                return 0;
+            }
+
+            write_stream.stream.seekp(offset, std::ios::beg);
+        }
+
+        if (write_stream.buffered_bytes + count > ZipWriteBufferSize) {
+            if (!write_stream.flush()) {
+                return 0;
+            }
+        }
+
+        if (count >= ZipWriteBufferSize) {
+            write_stream.stream.write((const char *)(bytes), count);
+        }
+        else {
+            // The buffer is only allocated once it's needed, as large writes skip it entirely.
+            if (write_stream.buffer.empty()) {
+                write_stream.buffer.resize(ZipWriteBufferSize);
+            }
+
+            memcpy(write_stream.buffer.data() + write_stream.buffered_bytes, bytes, count);
+            write_stream.buffered_bytes += count;
+        }
+
+        write_stream.position = offset + count;
+        write_stream.progress.advance(count);
+        return write_stream.stream.bad() ? 0 : count;
+    }
+
+    // Extracts the file at the given index into the stream and closes it. Returns false if the extraction failed,
+    // in which case the caller is responsible for deleting the partially written file.
+    static bool extract_zip_file(mz_zip_archive *zip_archive, mz_uint file_index, ZipWriteStream &write_stream) {
+        bool extracted = mz_zip_reader_extract_to_callback(zip_archive, file_index, &zip_write_func, &write_stream, 0);
+        extracted = write_stream.flush() && extracted;
+        write_stream.stream.close();
+        return extracted && !write_stream.stream.bad();
+    }
+
+    // Writes a file that was already extracted into memory into the stream and closes it.
+    static bool write_zip_file_bytes(const std::vector<char> &bytes, ZipWriteStream &write_stream) {
+        bool written = bytes.empty() || (zip_write_func(&write_stream, 0, bytes.data(), bytes.size()) == bytes.size());
+        written = write_stream.flush() && written;
+        write_stream.stream.close();
+        return written && !write_stream.stream.bad();
+    }
+
+    // Copies the file in blocks so that progress can be reported and the copy can be cancelled.
+    static bool copy_mod_file(const std::filesystem::path &src_path, const std::filesystem::path &dst_path, ArchiveProgress &progress) {
+        std::ifstream input_stream(src_path, std::ios::binary);
+        std::ofstream output_stream(dst_path, std::ios::binary);
+        if (!input_stream.is_open() || !output_stream.is_open()) {
+            return false;
+        }
+
+        std::vector<char> buffer(ZipWriteBufferSize);
+        while (input_stream) {
+            if (progress.context.is_cancelled()) {
+                return false;
+            }
+
+            input_stream.read(buffer.data(), buffer.size());
+            std::streamsize read_count = input_stream.gcount();
+            if (read_count > 0) {
+                output_stream.write(buffer.data(), read_count);
+                progress.advance(size_t(read_count));
+            }
+
+            if (output_stream.bad()) {
+                return false;
+            }
+        }
+
+        output_stream.close();
+        return !input_stream.bad() && !output_stream.bad();
+    }
+
+    // Checks whether the archive is a mod by reading only its manifest, or its texture database if it's an rtz file.
+    // Fills in the installation details if it is.
+    static bool probe_mod_archive(mz_zip_archive *zip_archive, const std::filesystem::path &target_path, ModInstaller::Installation &installation) {
+        int manifest_index = mz_zip_reader_locate_file(zip_archive, ManifestFilename.c_str(), nullptr, 0);
+        if (manifest_index >= 0) {
+            mz_zip_archive_file_stat manifest_stat;
+            if (!mz_zip_reader_file_stat(zip_archive, mz_uint(manifest_index), &manifest_stat)) {
+                return false;
+            }
+
+            std::vector<char> manifest_bytes(size_t(manifest_stat.m_uncomp_size));
+            if (!mz_zip_reader_extract_to_mem(zip_archive, mz_uint(manifest_index), manifest_bytes.data(), manifest_bytes.size(), 0)) {
+                return false;
+            }
+
             // Parse the manifest file to check for its validity.
             std::string error;
             recomp::mods::ModManifest manifest;
-            recomp::mods::ModOpenError open_error = parse_manifest(manifest, manifest_bytes, error);
-            exists = (open_error == recomp::mods::ModOpenError::Good);
-
-            if (exists) {
-                installation.mod_id = manifest.mod_id;
-                installation.display_name = manifest.display_name;
-                installation.mod_version = manifest.version;
-                installation.mod_file = target_path;
+            if (parse_manifest(manifest, manifest_bytes, error) != recomp::mods::ModOpenError::Good) {
+                return false;
             }
+
+            installation.mod_id = manifest.mod_id;
+            installation.display_name = manifest.display_name;
+            installation.mod_version = manifest.version;
+            installation.mod_file = target_path;
+            return true;
         }
-        else if (file_path.extension() == ".rtz") {
+        else if (target_path.extension() == ".rtz") {
             // When it's an rtz file, check if the texture database file exists.
-            exists = mz_zip_reader_locate_file(file_handle.archive.get(), TextureDatabaseFilename, nullptr, 0) >= 0;
+            if (mz_zip_reader_locate_file(zip_archive, TextureDatabaseFilename, nullptr, 0) < 0) {
+                return false;
+            }
+
+            installation.mod_id = std::string((const char *)(target_path.stem().u8string().c_str()));
+            installation.display_name = installation.mod_id;
+            installation.mod_version = recomp::Version{0, 0, 0, ""};
+            installation.mod_file = target_path;
+            return true;
+        }
+
+        return false;
+    }
+
+    // Range of a package that holds an uncompressed file, so the file can be read as an archive of its own.
+    struct ZipFileRange {
+        mz_zip_archive *zip_archive;
+        mz_uint64 offset;
+        mz_uint64 size;
+    };
+
+    static size_t zip_range_read_func(void *opaque, mz_uint64 offset, void *bytes, size_t count) {
+        ZipFileRange &range = *(ZipFileRange *)(opaque);
+        if (offset >= range.size) {
+            return 0;
+        }
+
+        count = size_t(std::min(mz_uint64(count), range.size - offset));
+        return range.zip_archive->m_pRead(range.zip_archive->m_pIO_opaque, range.offset + offset, bytes, count);
+    }
+
+    enum class ProbeResult {
+        Valid,
+        Invalid,
+        NeedsExtraction
+    };
+
+    // Validates a mod inside a package without writing it to disk. Uncompressed mods are read in place from the
+    // package. Small compressed mods are inflated into bytes_out, which can then be written out directly instead of
+    // being extracted again. Large compressed mods can only be read by extracting them first.
+    static ProbeResult probe_packaged_mod(mz_zip_archive *zip_archive, const mz_zip_archive_file_stat &file_stat, const std::filesystem::path &target_path, ModInstaller::Installation &installation, std::vector<char> &bytes_out) {
+        mz_zip_archive mod_archive{};
+        bool initialized = false;
+        if ((file_stat.m_method == 0) && !file_stat.m_is_encrypted && (file_stat.m_comp_size == file_stat.m_uncomp_size)) {
+            // The central directory doesn't know where the file's data starts, so the local header has to be read.
+            uint8_t local_header[ZipLocalHeaderSize];
+            if (zip_archive->m_pRead(zip_archive->m_pIO_opaque, file_stat.m_local_header_ofs, local_header, sizeof(local_header)) != sizeof(local_header)) {
+                return ProbeResult::Invalid;
+            }
+
+            uint32_t signature = uint32_t(local_header[0]) | (uint32_t(local_header[1]) << 8) | (uint32_t(local_header[2]) << 16) | (uint32_t(local_header[3]) << 24);
+            if (signature != ZipLocalHeaderSignature) {
+                return ProbeResult::Invalid;
+            }
 
-            if (exists) {
-                installation.mod_id = std::string((const char *)(target_path.stem().u8string().c_str()));
-                installation.display_name = installation.mod_id;
-                installation.mod_version = recomp::Version{0, 0, 0, ""};
-                installation.mod_file = target_path;
+            uint32_t filename_length = uint32_t(local_header[26]) | (uint32_t(local_header[27]) << 8);
+            uint32_t extra_length = uint32_t(local_header[28]) | (uint32_t(local_header[29]) << 8);
+            ZipFileRange range{ zip_archive, file_stat.m_local_header_ofs + ZipLocalHeaderSize + filename_length + extra_length, file_stat.m_uncomp_size };
+            mod_archive.m_pRead = &zip_range_read_func;
+            mod_archive.m_pIO_opaque = &range;
+            initialized = mz_zip_reader_init(&mod_archive, range.size, 0);
+            bool valid = initialized && probe_mod_archive(&mod_archive, target_path, installation);
+            if (initialized) {
+                mz_zip_reader_end(&mod_archive);
             }
+
+            return valid ? ProbeResult::Valid : ProbeResult::Invalid;
+        }
+        else if (file_stat.m_uncomp_size <= MaxInMemoryProbeSize) {
+            bytes_out.resize(size_t(file_stat.m_uncomp_size));
+            if (!mz_zip_reader_extract_to_mem(zip_archive, file_stat.m_file_index, bytes_out.data(), bytes_out.size(), 0)) {
+                bytes_out.clear();
+                return ProbeResult::Invalid;
+            }
+
+            initialized = mz_zip_reader_init_mem(&mod_archive, bytes_out.data(), bytes_out.size(), 0);
+            bool valid = initialized && probe_mod_archive(&mod_archive, target_path, installation);
+            if (initialized) {
+                mz_zip_reader_end(&mod_archive);
+            }
+
+            if (!valid) {
+                bytes_out.clear();
+            }
+
+            return valid ? ProbeResult::Valid : ProbeResult::Invalid;
+        }
+        else {
+            return ProbeResult::NeedsExtraction;
         }
+    }
+
+    void start_single_mod_installation(const std::filesystem::path &file_path, recomp::mods::ZipModFileHandle &file_handle, InstallationContext &context, ModInstaller::Result &result) {
+        // Check for the existence of the manifest file.
+        std::filesystem::path mods_directory = recomp::mods::get_mods_directory();
+        std::filesystem::path target_path = mods_directory / file_path.filename();
+        std::filesystem::path target_write_path = target_path.u8string() + NewExtension;
+        ModInstaller::Installation installation;
+        bool exists = probe_mod_archive(file_handle.archive.get(), target_path, installation);
 
         std::error_code ec;
         if (exists) {
-            std::filesystem::copy(file_path, target_write_path, ec);
-            if (ec) {
+            if (!claim_target_path(context, target_path)) {
+                result.error_messages.emplace_back(file_path.filename().string() + " was provided more than once.");
+                return;
+            }
+
+            ArchiveProgress progress{ context, file_path };
+            uintmax_t file_size = std::filesystem::file_size(file_path, ec);
+            progress.total_bytes = ec ? 0 : size_t(file_size);
+            progress.report();
+
+            if (!copy_mod_file(file_path, target_write_path, progress)) {
+                std::filesystem::remove(target_write_path, ec);
                 result.error_messages.emplace_back("Unable to install " + file_path.filename().string() + " to mod directory.");
                 return;
             }
@@ -92,16 +357,35 @@ namespace recompui {
         result.pending_installations.emplace_back(installation);
     }
 
-    void start_package_mod_installation(const std::filesystem::path &path, recomp::mods::ZipModFileHandle &file_handle, std::function<void(std::filesystem::path, size_t, size_t)> progress_callback, ModInstaller::Result &result) {
+    void start_package_mod_installation(const std::filesystem::path &path, recomp::mods::ZipModFileHandle &file_handle, InstallationContext &context, ModInstaller::Result &result) {
         std::error_code ec;
         char filename[1024];
         std::filesystem::path mods_directory = recomp::mods::get_mods_directory();
         mz_zip_archive *zip_archive = file_handle.archive.get();
         mz_uint num_files = mz_zip_reader_get_num_files(file_handle.archive.get());
+
+        // Progress is measured in the amount of bytes that will be extracted from the package.
+        ArchiveProgress progress{ context, path };
+        for (mz_uint i = 0; i < num_files; i++) {
+            mz_zip_archive_file_stat file_stat;
+            if (mz_zip_reader_file_stat(zip_archive, i, &file_stat)) {
+                std::filesystem::path file_path = std::u8string_view((const char8_t *)(file_stat.m_filename));
+                if ((file_path.extension() == ".rtz") || (file_path.extension() == ".nrm") || is_dynamic_lib(file_path)) {
+                    progress.total_bytes += size_t(file_stat.m_uncomp_size);
+                }
+            }
+        }
+
+        progress.report();
+
         std::list<std::filesystem::path> dynamic_lib_files;
         std::list<ModInstaller::Installation>::iterator first_nrm_iterator = result.pending_installations.end();
         bool found_mod = false;
         for (mz_uint i = 0; i < num_files; i++) {
+            if (context.is_cancelled()) {
+                break;
+            }
+
             mz_uint filename_length = mz_zip_reader_get_filename(zip_archive, i, filename, sizeof(filename));
             if (filename_length == 0) {
                 continue;
@@ -111,73 +395,60 @@ namespace recompui {
             if ((target_path.extension() == ".rtz") || (target_path.extension() == ".nrm")) {
                 found_mod = true;
                 ModInstaller::Installation installation;
-                std::filesystem::path target_write_path = target_path.u8string() + NewExtension;
-                std::ofstream output_stream(target_write_path, std::ios::binary);
-                if (!output_stream.is_open()) {
-                    result.error_messages.emplace_back("Unable to write to mod directory.");
-                    continue;
+                mz_zip_archive_file_stat file_stat{};
+                std::vector<char> mod_bytes;
+                ProbeResult probe_result = ProbeResult::Invalid;
+                if (mz_zip_reader_file_stat(zip_archive, i, &file_stat)) {
+                    probe_result = probe_packaged_mod(zip_archive, file_stat, target_path, installation, mod_bytes);
                 }
 
-                if (!mz_zip_reader_extract_to_callback(zip_archive, i, &zip_write_func, &output_stream, 0)) {
-                    output_stream.close();
-                    std::filesystem::remove(target_write_path, ec);
-                    result.error_messages.emplace_back("Failed to install " + path.filename().string() + " to mod directory.");
+                // Invalid mods are rejected before anything is written to the mod directory.
+                if (probe_result == ProbeResult::Invalid) {
+                    result.error_messages.emplace_back("Invalid mod (" + target_path.filename().string() + ") in " + path.filename().string() + ".");
+                    progress.advance(size_t(file_stat.m_uncomp_size));
                     continue;
                 }
 
-                output_stream.close();
-                if (output_stream.bad()) {
-                    std::filesystem::remove(target_write_path, ec);
-                    result.error_messages.emplace_back("Failed to install " + path.filename().string() + " to mod directory.");
+                if (!claim_target_path(context, target_path)) {
+                    result.error_messages.emplace_back(target_path.filename().string() + " in " + path.filename().string() + " was provided more than once.");
                     continue;
                 }
 
-                // Try to load the extracted file as a mod file handle.
-                recomp::mods::ModOpenError open_error;
-                std::unique_ptr<recomp::mods::ZipModFileHandle> extracted_file_handle = std::make_unique<recomp::mods::ZipModFileHandle>(target_write_path, open_error);
-                if (open_error != recomp::mods::ModOpenError::Good) {
-                    result.error_messages.emplace_back("Invalid mod (" + target_path.filename().string() + ") in " + path.filename().string() + ".");
-                    extracted_file_handle.reset();
-                    std::filesystem::remove(target_write_path, ec);
+                std::filesystem::path target_write_path = target_path.u8string() + NewExtension;
+                ZipWriteStream write_stream(target_write_path, progress);
+                if (!write_stream.stream.is_open()) {
+                    result.error_messages.emplace_back("Unable to write to mod directory.");
                     continue;
                 }
 
-                // Check for the existence of the manifest file.
-                bool exists = false;
-                std::vector<char> manifest_bytes = extracted_file_handle->read_file(ManifestFilename, exists);
-                if (exists) {
-                    // Parse the manifest file to check for its validity.
-                    std::string error;
-                    recomp::mods::ModManifest manifest;
-                    open_error = parse_manifest(manifest, manifest_bytes, error);
-                    exists = (open_error == recomp::mods::ModOpenError::Good);
-
-                    if (exists) {
-                        installation.mod_id = manifest.mod_id;
-                        installation.display_name = manifest.display_name;
-                        installation.mod_version = manifest.version;
-                        installation.mod_file = target_path;
-                    }
+                bool written;
+                if (mod_bytes.empty()) {
+                    written = extract_zip_file(zip_archive, i, write_stream);
                 }
-                else if (target_path.extension() == ".rtz") {
-                    // When it's an rtz file, check if the texture database file exists.
-                    exists = mz_zip_reader_locate_file(extracted_file_handle->archive.get(), TextureDatabaseFilename, nullptr, 0) >= 0;
-
-                    if (exists) {
-                        installation.mod_id = std::string((const char *)(target_path.stem().u8string().c_str()));
-                        installation.display_name = installation.mod_id;
-                        installation.mod_version = recomp::Version();
-                        installation.mod_file = target_path;
-                    }
+                else {
+                    // The mod was already inflated to validate it, so it only needs to be written out.
+                    written = write_zip_file_bytes(mod_bytes, write_stream);
                 }
 
-                if (!exists) {
-                    result.error_messages.emplace_back("Invalid mod (" + target_path.filename().string() + ") in " + path.filename().string() + ".");
-                    extracted_file_handle.reset();
+                if (!written) {
                     std::filesystem::remove(target_write_path, ec);
+                    result.error_messages.emplace_back("Failed to install " + path.filename().string() + " to mod directory.");
                     continue;
                 }
 
+                if (probe_result == ProbeResult::NeedsExtraction) {
+                    // Try to load the extracted file as a mod file handle.
+                    recomp::mods::ModOpenError open_error;
+                    std::unique_ptr<recomp::mods::ZipModFileHandle> extracted_file_handle = std::make_unique<recomp::mods::ZipModFileHandle>(target_write_path, open_error);
+                    bool valid = (open_error == recomp::mods::ModOpenError::Good) && probe_mod_archive(extracted_file_handle->archive.get(), target_path, installation);
+                    extracted_file_handle.reset();
+                    if (!valid) {
+                        result.error_messages.emplace_back("Invalid mod (" + target_path.filename().string() + ") in " + path.filename().string() + ".");
+                        std::filesystem::remove(target_write_path, ec);
+                        continue;
+                    }
+                }
+
                 if (std::filesystem::exists(installation.mod_file, ec)) {
                     installation.needs_overwrite_confirmation = true;
                 }
@@ -201,22 +472,19 @@ namespace recompui {
             }
             
             if (is_dynamic_lib(target_path)) {
-                std::filesystem::path target_write_path = target_path.u8string() + NewExtension;
-                std::ofstream output_stream(target_write_path, std::ios::binary);
-                if (!output_stream.is_open()) {
-                    result.error_messages.emplace_back("Failed to install " + path.filename().string() + " to mod directory.");
+                if (!claim_target_path(context, target_path)) {
+                    result.error_messages.emplace_back(target_path.filename().string() + " in " + path.filename().string() + " was provided more than once.");
                     continue;
                 }
 
-                if (!mz_zip_reader_extract_to_callback(zip_archive, i, &zip_write_func, &output_stream, 0)) {
-                    output_stream.close();
-                    std::filesystem::remove(target_write_path, ec);
+                std::filesystem::path target_write_path = target_path.u8string() + NewExtension;
+                ZipWriteStream write_stream(target_write_path, progress);
+                if (!write_stream.stream.is_open()) {
                     result.error_messages.emplace_back("Failed to install " + path.filename().string() + " to mod directory.");
                     continue;
                 }
 
-                output_stream.close();
-                if (output_stream.bad()) {
+                if (!extract_zip_file(zip_archive, i, write_stream)) {
                     std::filesystem::remove(target_write_path, ec);
                     result.error_messages.emplace_back("Failed to install " + path.filename().string() + " to mod directory.");
                     continue;
@@ -247,7 +515,7 @@ namespace recompui {
             }
         }
 
-        if (!found_mod) {
+        if (!found_mod && !context.is_cancelled()) {
             result.error_messages.emplace_back("No mods found in " + path.filename().string() + ".");
         }
     }
@@ -283,7 +551,26 @@ namespace recompui {
         std::filesystem::remove(old_path, ec);
     };
 
-    void ModInstaller::start_mod_installation(const std::list<std::filesystem::path> &file_paths, std::function<void(std::filesystem::path, size_t, size_t)> progress_callback, Result &result) {
+    static void install_mod_file(const std::filesystem::path &path, InstallationContext &context, ModInstaller::Result &result) {
+        recomp::mods::ModOpenError open_error;
+        recomp::mods::ZipModFileHandle file_handle(path, open_error);
+        if (open_error != recomp::mods::ModOpenError::Good) {
+            result.error_messages.emplace_back(path.filename().string() + " is not a valid zip or mod.");
+            return;
+        }
+
+        // First we verify if the container itself isn't a mod already.
+        // TODO hook into the runtime's container registration to check the extension instead of using hardcoded values.
+        if ((path.extension() == ".rtz") || (path.extension() == ".nrm")) {
+            start_single_mod_installation(path, file_handle, context, result);
+        }
+        else {
+            // Scan the container for compatible mods instead. This is the case for packages made by users or how they're tipically uploaded to Thunderstore.
+            start_package_mod_installation(path, file_handle, context, result);
+        }
+    }
+
+    void ModInstaller::start_mod_installation(const std::list<std::filesystem::path> &file_paths, std::function<void(std::filesystem::path, size_t, size_t)> progress_callback, Result &result, const std::atomic_bool *cancelled) {
         result = Result();
 
         for (const std::filesystem::path &path : file_paths) {
@@ -293,23 +580,41 @@ namespace recompui {
             }
         }
 
-        for (const std::filesystem::path &path : file_paths) {
-            recomp::mods::ModOpenError open_error;
-            recomp::mods::ZipModFileHandle file_handle(path, open_error);
-            if (open_error != recomp::mods::ModOpenError::Good) {
-                result.error_messages.emplace_back(path.filename().string() + " is not a valid zip or mod.");
-                continue;
+        // Each file is installed into its own result by whichever thread picks it up, and the results are merged
+        // afterwards in the order the files were provided in.
+        InstallationContext context;
+        context.progress_callback = std::move(progress_callback);
+        context.cancelled = cancelled;
+        std::vector<std::filesystem::path> paths(file_paths.begin(), file_paths.end());
+        std::vector<Result> file_results(paths.size());
+        std::atomic<size_t> next_file_index = 0;
+        auto install_thread_func = [&]() {
+            size_t file_index;
+            while (!context.is_cancelled() && ((file_index = next_file_index.fetch_add(1)) < paths.size())) {
+                install_mod_file(paths[file_index], context, file_results[file_index]);
             }
+        };
 
-            // First we verify if the container itself isn't a mod already.
-            // TODO hook into the runtime's container registration to check the extension instead of using hardcoded values.
-            if ((path.extension() == ".rtz") || (path.extension() == ".nrm")) {
-                start_single_mod_installation(path, file_handle, progress_callback, result);
-            }
-            else {
-                // Scan the container for compatible mods instead. This is the case for packages made by users or how they're tipically uploaded to Thunderstore.
-                start_package_mod_installation(path, file_handle, progress_callback, result);
-            }
+        uint32_t thread_count = std::clamp(std::thread::hardware_concurrency() / 2, 1U, MaxInstallThreads);
+        thread_count = std::min(thread_count, uint32_t(paths.size()));
+        std::vector<std::thread> install_threads;
+        for (uint32_t i = 1; i < thread_count; i++) {
+            install_threads.emplace_back(install_thread_func);
+        }
+
+        install_thread_func();
+
+        for (std::thread &thread : install_threads) {
+            thread.join();
+        }
+
+        for (Result &file_result : file_results) {
+            result.error_messages.splice(result.error_messages.end(), file_result.error_messages);
+            result.pending_installations.splice(result.pending_installations.end(), file_result.pending_installations);
+        }
+
+        if (context.is_cancelled()) {
+            result.error_messages.emplace_back("Mod installation was cancelled.");
         }
     }
 
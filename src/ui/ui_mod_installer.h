@@ -3,6 +3,8 @@
 
 #include <librecomp/game.hpp>
 
+#include <atomic>
+#include <functional>
 #include <unordered_set>
 #include <vector>
 #include <string>
@@ -33,7 +35,10 @@ namespace recompui {
             std::list<Installation> pending_installations;
         };
 
-        static void start_mod_installation(const std::list<std::filesystem::path> &file_paths, std::function<void(std::filesystem::path, size_t, size_t)> progress_callback, Result &result);
+        // Extracts and validates the provided files on multiple threads. The progress callback receives the file being
+        // installed and the amount of its bytes processed so far out of its total, and is never called concurrently.
+        // Setting the cancelled flag stops the installation early, after which the result should be cancelled.
+        static void start_mod_installation(const std::list<std::filesystem::path> &file_paths, std::function<void(std::filesystem::path, size_t, size_t)> progress_callback, Result &result, const std::atomic_bool *cancelled = nullptr);
         static void cancel_mod_installation(const Result& result, std::vector<std::string>& errors);
         static void finish_mod_installation(const Result &result, std::vector<std::string>& errors);
     };
@@ -2,12 +2,15 @@
 #include "runtime/support.hpp"
 
 #include "ui_mod_menu.h"
+#include "ui_thumbnail_cache.h"
 #include "ui_utils.h"
 #include "ui/recomp_ui.h"
 
 #include "librecomp/mods.hpp"
 
 #include <string>
+#include <string_view>
+#include <unordered_set>
 
 #ifdef WIN32
 #include <shellapi.h>
@@ -191,71 +194,30 @@ void ModEntryButton::process_event(const Event& e) {
     }
 }
 
-// ModEntrySpacer
+// ModMenu
 
-void ModEntrySpacer::check_height_distance() {
-    constexpr float tolerance = 0.01f;
-    if (abs(target_height - height) < tolerance) {
-        height = target_height;
-        set_height(height, Unit::Dp);
+void ModMenu::refresh_mods(bool scan_mods) {
+    if (scan_mods) {
+        recomp::mods::scan_mods();
     }
-    else {
-        queue_update();
+    mod_details = recomp::mods::get_all_mod_details(game_mod_id);
+
+    // Only release the thumbnails of mods that are gone or whose thumbnail changed. The rest stay loaded.
+    std::unordered_set<std::string> mod_ids;
+    for (const recomp::mods::ModDetails &details : mod_details) {
+        mod_ids.emplace(details.mod_id);
     }
-}
 
-void ModEntrySpacer::process_event(const Event &e) {
-    switch (e.type) {
-    case EventType::Update: {
-        std::chrono::high_resolution_clock::duration now = ultramodern::time_since_start();
-        float delta_time = std::max(std::chrono::duration<float>(now - last_time).count(), 0.0f);
-        constexpr float dp_speed = 1000.0f;
-        last_time = now;
-
-        if (target_height < height) {
-            height += std::max(-dp_speed * delta_time, target_height - height);
+    for (auto it = loaded_thumbnails.begin(); it != loaded_thumbnails.end();) {
+        if (mod_ids.contains(it->first) && get_mod_thumbnail_key(it->first) == it->second) {
+            ++it;
         }
         else {
-            height += std::min(dp_speed * delta_time, target_height - height);
+            recompui::release_image(generate_thumbnail_src_for_mod(it->first));
+            it = loaded_thumbnails.erase(it);
         }
-
-        set_height(height, Unit::Dp);
-        check_height_distance();
-        break;
     }
-    default:
-        break;
-    }
-}
-
-ModEntrySpacer::ModEntrySpacer(Element *parent) : Element(parent) {
-    // Do nothing.
-}
-
-void ModEntrySpacer::set_target_height(float target_height, bool animate_to_target) {
-    this->target_height = target_height;
-
-    if (animate_to_target) {
-        last_time = ultramodern::time_since_start();
-        check_height_distance();
-    }
-    else {
-        height = target_height;
-        set_height(target_height, Unit::Dp);
-    }
-}
 
-// ModMenu
-
-void ModMenu::refresh_mods(bool scan_mods) {
-    for (const std::string &thumbnail : loaded_thumbnails) {
-        recompui::release_image(thumbnail);
-    }
-
-    if (scan_mods) {
-        recomp::mods::scan_mods();
-    }
-    mod_details = recomp::mods::get_all_mod_details(game_mod_id);
     create_mod_list();
 }
 
@@ -294,20 +256,25 @@ void ModMenu::mod_toggled(bool enabled) {
         recomp::mods::enable_mod(mod_details[active_mod_index].mod_id, enabled);
         
         // Refresh enabled status for all mods in case one of them got auto-enabled due to being a dependency.
-        for (size_t i = 0; i < mod_entry_buttons.size(); i++) {
-            mod_entry_buttons[i]->set_mod_enabled(is_mod_enabled_or_auto(mod_details[i].mod_id));
-        }
+        mod_list->rebind_rows();
     }
 }
 
 void ModMenu::mod_selected(uint32_t mod_index) {
     if (active_mod_index >= 0) {
-        mod_entry_buttons[active_mod_index]->set_selected(false);
+        ModEntryButton *prev_mod_entry = get_mod_entry(active_mod_index);
+        if (prev_mod_entry != nullptr) {
+            prev_mod_entry->set_selected(false);
+        }
     }
 
     active_mod_index = mod_index;
 
+    // Keep the selected entry around while it's scrolled out of view, since it may have focus.
+    mod_list->set_pinned_index(active_mod_index);
+
     if (active_mod_index >= 0) {
+        load_mod_thumbnail(mod_details[mod_index].mod_id);
         std::string thumbnail_src = generate_thumbnail_src_for_mod(mod_details[mod_index].mod_id);
         const recomp::mods::ConfigSchema &config_schema = recomp::mods::get_mod_config_schema(mod_details[active_mod_index].mod_id);
         bool toggle_checked = is_mod_enabled_or_auto(mod_details[mod_index].mod_id);
@@ -315,9 +282,10 @@ void ModMenu::mod_selected(uint32_t mod_index) {
         bool toggle_enabled = !auto_enabled && (mod_details[mod_index].runtime_toggleable || !ultramodern::is_game_started());
         bool configure_enabled = !config_schema.options.empty();
         mod_details_panel->set_mod_details(mod_details[mod_index], thumbnail_src, toggle_checked, toggle_enabled, auto_enabled, configure_enabled);
-        mod_entry_buttons[active_mod_index]->set_selected(true);
+        ModEntryButton *mod_entry = get_mod_entry(mod_index);
+        mod_entry->set_selected(true);
 
-        mod_details_panel->setup_mod_navigation(mod_entry_buttons[mod_index]);
+        mod_details_panel->setup_mod_navigation(mod_entry);
 
         // Navigation from the bottom bar.
         Button *configure_button = mod_details_panel->get_configure_button();
@@ -337,35 +305,32 @@ void ModMenu::mod_selected(uint32_t mod_index) {
 
         // Navigation from the mod list.
         if (toggle_enabled) {
-            mod_entry_buttons[active_mod_index]->set_nav(NavDirection::Right, enable_toggle);
+            mod_entry_nav_right = enable_toggle;
         }
         else if (configure_enabled) {
-            mod_entry_buttons[active_mod_index]->set_nav(NavDirection::Right, configure_button);
+            mod_entry_nav_right = configure_button;
         }
         else {
-            mod_entry_buttons[active_mod_index]->set_nav_none(NavDirection::Right);
+            mod_entry_nav_right = nullptr;
         }
+        setup_mod_entry_navigation(mod_entry, mod_index);
     }
 }
 
 void ModMenu::mod_dragged(uint32_t mod_index, EventDrag drag) {
-    constexpr float spacer_height = modEntryHeight + modEntryPadding * 2.0f;
-
     switch (drag.phase) {
     case DragPhase::Start: {
-        for (size_t i = 0; i < mod_entry_buttons.size(); i++) {
-            mod_entry_middles[i] = mod_entry_buttons[i]->get_absolute_top() + mod_entry_buttons[i]->get_client_height() / 2.0f;
-        }
-
         // When the drag phase starts, we make the floating mod details visible and store the relative coordinate of the
-        // mouse cursor. Instantly hide the real element and use a spacer in its place that will stay on the same size as
+        // mouse cursor. Instantly hide the real element and leave a gap in its place that will stay on the same size as
         // long as the cursor is hovering over this slot.
-        float width = mod_entry_buttons[mod_index]->get_client_width();
-        float height = mod_entry_buttons[mod_index]->get_client_height();
-        float left = mod_entry_buttons[mod_index]->get_absolute_left() - get_absolute_left();
-        float top = mod_entry_buttons[mod_index]->get_absolute_top() - (height / 2.0f); // TODO: Figure out why this adjustment is even necessary.
-        mod_entry_buttons[mod_index]->set_display(Display::None);
-        mod_entry_buttons[mod_index]->set_focused(false);
+        ModEntryButton *mod_entry = get_mod_entry(mod_index);
+        float width = mod_entry->get_client_width();
+        float height = mod_entry->get_client_height();
+        float left = mod_entry->get_absolute_left() - get_absolute_left();
+        float top = mod_entry->get_absolute_top() - (height / 2.0f); // TODO: Figure out why this adjustment is even necessary.
+        mod_list->set_hidden_index(mod_index);
+        mod_list->set_gap_index(mod_index, false);
+        mod_entry->set_focused(false);
         mod_entry_floating_view->set_display(Display::Flex);
         mod_entry_floating_view->set_mod_details(mod_details[mod_index]);
         mod_entry_floating_view->set_mod_thumbnail(generate_thumbnail_src_for_mod(mod_details[mod_index].mod_id));
@@ -380,31 +345,16 @@ void ModMenu::mod_dragged(uint32_t mod_index, EventDrag drag) {
         mod_drag_view_coordinates[1] = top;
         
         mod_drag_target_index = mod_index;
-        mod_entry_spacers[mod_drag_target_index]->set_target_height(spacer_height, false);
         break;
     }
     case DragPhase::Move: {
-        // Binary search for the drag area.
-        uint32_t low = 0;
-        uint32_t high = mod_entry_buttons.size();
-        while (low < high) {
-            uint32_t mid = low + (high - low) / 2;
-            if (drag.y < mod_entry_middles[mid]) {
-                high = mid;
-            }
-            else {
-                low = mid + 1;
-            }
-        }
-        
-        uint32_t new_index = low;
+        uint32_t new_index = mod_list->get_gap_index_at(drag.y);
         float delta_x = drag.x - mod_drag_start_coordinates[0];
         float delta_y = drag.y - mod_drag_start_coordinates[1];
         mod_entry_floating_view->set_left(mod_drag_view_coordinates[0] + delta_x, Unit::Px);
         mod_entry_floating_view->set_top(mod_drag_view_coordinates[1] + delta_y, Unit::Px);
         if (mod_drag_target_index != new_index) {
-            mod_entry_spacers[mod_drag_target_index]->set_target_height(0.0f, true);
-            mod_entry_spacers[new_index]->set_target_height(spacer_height, true);
+            mod_list->set_gap_index(new_index, true);
             mod_drag_target_index = new_index;
         }
 
@@ -412,9 +362,8 @@ void ModMenu::mod_dragged(uint32_t mod_index, EventDrag drag) {
     }
     case DragPhase::End: {
         // Dragging has ended, hide the floating view.
-        mod_entry_buttons[mod_index]->set_display(Display::Block);
-        mod_entry_buttons[mod_index]->set_selected(false);
-        mod_entry_spacers[mod_drag_target_index]->set_target_height(0.0f, false);
+        mod_list->set_hidden_index(-1);
+        mod_list->set_gap_index(-1, false);
         mod_entry_floating_view->set_display(Display::None);
 
         // Result needs a small substraction when dragging downwards.
@@ -425,14 +374,9 @@ void ModMenu::mod_dragged(uint32_t mod_index, EventDrag drag) {
         // Re-order the mods and update all the details on the menu.
         recomp::mods::set_mod_index(game_mod_id, mod_details[mod_index].mod_id, mod_drag_target_index);
         mod_details = recomp::mods::get_all_mod_details(game_mod_id);
-        for (size_t i = 0; i < mod_entry_buttons.size(); i++) {
-            mod_entry_buttons[i]->set_mod_details(mod_details[i]);
-            mod_entry_buttons[i]->set_mod_thumbnail(generate_thumbnail_src_for_mod(mod_details[i].mod_id));
-            mod_entry_buttons[i]->set_mod_enabled(is_mod_enabled_or_auto(mod_details[i].mod_id));
-        }
-
-        mod_entry_buttons[mod_drag_target_index]->set_selected(true);
         active_mod_index = mod_drag_target_index;
+        mod_list->set_pinned_index(active_mod_index);
+        mod_list->rebind_rows();
 
         break;
     }
@@ -550,41 +494,109 @@ void ModMenu::mod_hd_textures_enabled_changed(uint32_t value) {
     }
 }
 
-void ModMenu::create_mod_list() {
-    ContextId context = get_current_context();
-    
-    // Clear the contents of the list scroll.
-    list_scroll_container->clear_children();
-    mod_entry_buttons.clear();
-    mod_entry_spacers.clear();
-
-    Toggle* enable_toggle = mod_details_panel->get_enable_toggle();
-
-    // Create the child elements for the list scroll.
-    for (size_t mod_index = 0; mod_index < mod_details.size(); mod_index++) {
-        const std::vector<char> &thumbnail = recomp::mods::get_mod_thumbnail(mod_details[mod_index].mod_id);
-        std::string thumbnail_name = generate_thumbnail_src_for_mod(mod_details[mod_index].mod_id);
-        if (!thumbnail.empty()) {
-            recompui::queue_image_from_bytes_file(thumbnail_name, thumbnail);
-            loaded_thumbnails.emplace(thumbnail_name);
+ThumbnailCacheKey ModMenu::get_mod_thumbnail_key(const std::string &mod_id) {
+    ThumbnailCacheKey key;
+    if (!get_thumbnail_cache_key(recomp::mods::get_mod_filename(mod_id), key)) {
+        // The mod isn't a single file, so identify its thumbnail by its contents instead.
+        const std::vector<char> &thumbnail = recomp::mods::get_mod_thumbnail(mod_id);
+        key.file_size = std::hash<std::string_view>{}(std::string_view{ thumbnail.data(), thumbnail.size() });
+    }
+
+    return key;
+}
+
+void ModMenu::load_mod_thumbnail(const std::string &mod_id) {
+    if (loaded_thumbnails.contains(mod_id)) {
+        return;
+    }
+
+    // Use the decoded thumbnail from the cache when possible so the mod's archive doesn't need to be opened.
+    ThumbnailCacheKey key = get_mod_thumbnail_key(mod_id);
+    std::string thumbnail_src = generate_thumbnail_src_for_mod(mod_id);
+    if (!key.mod_path.empty()) {
+        CachedThumbnail cached_thumbnail;
+        auto read_thumbnail = [&mod_id]() -> const std::vector<char> & { return recomp::mods::get_mod_thumbnail(mod_id); };
+        if (load_cached_thumbnail(key, read_thumbnail, cached_thumbnail)) {
+            if (!cached_thumbnail.empty()) {
+                recompui::queue_image_from_bytes_rgba32(thumbnail_src, cached_thumbnail.pixels, cached_thumbnail.width, cached_thumbnail.height);
+            }
+
+            loaded_thumbnails.emplace(mod_id, std::move(key));
+            return;
         }
+    }
+
+    const std::vector<char> &thumbnail = recomp::mods::get_mod_thumbnail(mod_id);
+    if (!thumbnail.empty()) {
+        recompui::queue_image_from_bytes_file(thumbnail_src, thumbnail);
+    }
+
+    loaded_thumbnails.emplace(mod_id, std::move(key));
+}
+
+ModEntryButton *ModMenu::get_mod_entry(uint32_t mod_index) {
+    return static_cast<ModEntryButton *>(mod_list->get_row(mod_index));
+}
+
+Element *ModMenu::create_mod_entry(Element *parent) {
+    ContextId context = get_current_context();
+    ModEntryButton *mod_entry = context.create_element<ModEntryButton>(parent, 0);
+    mod_entry->set_mod_selected_callback([this](uint32_t mod_index){ mod_selected(mod_index); });
+    mod_entry->set_mod_drag_callback([this](uint32_t mod_index, recompui::EventDrag drag){ mod_dragged(mod_index, drag); });
+    return mod_entry;
+}
+
+void ModMenu::bind_mod_entry(Element *row, uint32_t mod_index) {
+    // Thumbnails are only loaded once an entry for the mod is about to become visible.
+    load_mod_thumbnail(mod_details[mod_index].mod_id);
 
-        ModEntrySpacer *spacer = context.create_element<ModEntrySpacer>(list_scroll_container);
-        mod_entry_spacers.emplace_back(spacer);
+    ModEntryButton *mod_entry = static_cast<ModEntryButton *>(row);
+    mod_entry->set_mod_index(mod_index);
+    mod_entry->set_mod_details(mod_details[mod_index]);
+    mod_entry->set_mod_thumbnail(generate_thumbnail_src_for_mod(mod_details[mod_index].mod_id));
+    mod_entry->set_mod_enabled(is_mod_enabled_or_auto(mod_details[mod_index].mod_id));
+    mod_entry->set_selected(int32_t(mod_index) == active_mod_index);
+    setup_mod_entry_navigation(mod_entry, mod_index);
+}
+
+void ModMenu::setup_mod_entry_navigation(ModEntryButton *mod_entry, uint32_t mod_index) {
+    if (mod_index == 0) {
+        mod_entry->set_nav_manual(NavDirection::Up, mod_tab_id);
+    }
+    else {
+        mod_entry->set_nav_auto(NavDirection::Up);
+    }
 
-        ModEntryButton *mod_entry = context.create_element<ModEntryButton>(list_scroll_container, mod_index);
-        mod_entry->set_mod_selected_callback([this](uint32_t mod_index){ mod_selected(mod_index); });
-        mod_entry->set_mod_drag_callback([this](uint32_t mod_index, recompui::EventDrag drag){ mod_dragged(mod_index, drag); });
-        mod_entry->set_mod_details(mod_details[mod_index]);
-        mod_entry->set_mod_thumbnail(thumbnail_name);
-        mod_entry->set_mod_enabled(is_mod_enabled_or_auto(mod_details[mod_index].mod_id));
-        mod_entry_buttons.emplace_back(mod_entry);
+    if (mod_index + 1 == mod_details.size()) {
+        mod_entry->set_nav(NavDirection::Down, install_mods_button);
+    }
+    else {
+        mod_entry->set_nav_auto(NavDirection::Down);
+    }
+
+    if (int32_t(mod_index) != active_mod_index) {
+        mod_entry->set_nav_auto(NavDirection::Right);
+    }
+    else if (mod_entry_nav_right != nullptr) {
+        mod_entry->set_nav(NavDirection::Right, mod_entry_nav_right);
+    }
+    else {
+        mod_entry->set_nav_none(NavDirection::Right);
     }
+}
+
+void ModMenu::create_mod_list() {
+    active_mod_index = -1;
+    mod_list->set_pinned_index(-1);
+
+    // Only the entries close to the visible part of the list get elements, which are bound to mods as it scrolls.
+    mod_list->set_count(uint32_t(mod_details.size()));
 
-    if (!mod_entry_buttons.empty()) {
-        mod_entry_buttons.front()->set_nav_manual(NavDirection::Up, mod_tab_id);
-        mod_entry_buttons.back()->set_nav(NavDirection::Down, install_mods_button);
-        install_mods_button->set_nav(NavDirection::Up, mod_entry_buttons.back());
+    bool mods_available = !mod_details.empty();
+
+    // The last entry might not have an element, so navigating up from the install button goes to whichever entry is closest.
+    if (mods_available) {
+        install_mods_button->set_nav_auto(NavDirection::Up);
     }
     else {
         install_mods_button->set_nav_manual(NavDirection::Up, mod_tab_id);
@@ -595,13 +607,6 @@ void ModMenu::create_mod_list() {
         recompui::set_config_tabset_mod_nav();
     }       
 
-    // Add one extra spacer at the bottom.
-    ModEntrySpacer *spacer = context.create_element<ModEntrySpacer>(list_scroll_container);
-    mod_entry_spacers.emplace_back(spacer);
-
-    mod_entry_middles.resize(mod_entry_buttons.size());
-
-    bool mods_available = !mod_details.empty();
     body_container->set_display(mods_available ? Display::Flex : Display::None);
     body_empty_container->set_display(mods_available ? Display::None : Display::Flex);
     if (mods_available) {
@@ -657,7 +662,10 @@ ModMenu::ModMenu(Element *parent) : Element(parent) {
             list_container->set_background_color(Color{ 0, 0, 0, 89 });
             list_container->set_border_bottom_left_radius(16.0f);
             {
-                list_scroll_container = context.create_element<ScrollContainer>(list_container, ScrollDirection::Vertical);
+                constexpr float mod_entry_row_height = modEntryHeight + modEntryPadding * 2.0f;
+                mod_list = context.create_element<VirtualList>(list_container, mod_entry_row_height,
+                    [this](Element *parent) { return create_mod_entry(parent); },
+                    [this](Element *row, uint32_t mod_index) { bind_mod_entry(row, mod_index); });
             } // list_container
 
             mod_details_panel = context.create_element<ModDetailsPanel>(body_container);
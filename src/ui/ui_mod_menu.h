@@ -2,9 +2,10 @@
 #define RECOMPUI_ELEMENT_MOD_MENU_H
 
 #include "librecomp/mods.hpp"
-#include "elements/ui_scroll_container.h"
+#include "elements/ui_virtual_list.h"
 #include "ui_config_sub_menu.h"
 #include "ui_mod_details_panel.h"
+#include "ui_thumbnail_cache.h"
 
 namespace recompui {
 
@@ -37,6 +38,7 @@ class ModEntryButton : public Element {
 public:
     ModEntryButton(Element *parent, uint32_t mod_index);
     virtual ~ModEntryButton();
+    void set_mod_index(uint32_t mod_index) { this->mod_index = mod_index; }
     void set_mod_selected_callback(std::function<void(uint32_t)> callback);
     void set_mod_drag_callback(std::function<void(uint32_t, EventDrag)> callback);
     void set_mod_details(const recomp::mods::ModDetails &details);
@@ -54,27 +56,12 @@ private:
     std::function<void(uint32_t, EventDrag)> drag_callback = nullptr;
 };
 
-class ModEntrySpacer : public Element {
-private:
-    float height = 0.0f;
-    float target_height = 0.0f;
-    std::chrono::high_resolution_clock::duration last_time;
-
-    void check_height_distance();
-protected:
-    virtual void process_event(const Event &e) override;
-    std::string_view get_type_name() override { return "ModEntrySpacer"; }
-public:
-    ModEntrySpacer(Element *parent);
-    void set_target_height(float target_height, bool animate_to_target);
-};
-
 class ModMenu : public Element {
 public:
     ModMenu(Element *parent);
     virtual ~ModMenu();
     void set_mods_dirty(bool scan_mods) { mods_dirty = true; mod_scan_queued = scan_mods; }
-    Element* get_first_mod_entry() { return !mod_entry_buttons.empty() ? mod_entry_buttons[0] : nullptr; }
+    Element* get_first_mod_entry() { return mod_list != nullptr ? mod_list->get_first_row() : nullptr; }
     Element* get_mod_configure_button() { return mod_details_panel != nullptr ? mod_details_panel->get_configure_button() : nullptr; }
 protected:
     std::string_view get_type_name() override { return "ModMenu"; }
@@ -92,11 +79,17 @@ private:
     void mod_number_option_changed(const std::string &id, double value);
     void mod_hd_textures_enabled_changed(uint32_t value);
     void create_mod_list();
+    ThumbnailCacheKey get_mod_thumbnail_key(const std::string &mod_id);
+    void load_mod_thumbnail(const std::string &mod_id);
+    ModEntryButton *get_mod_entry(uint32_t mod_index);
+    Element *create_mod_entry(Element *parent);
+    void bind_mod_entry(Element *row, uint32_t mod_index);
+    void setup_mod_entry_navigation(ModEntryButton *mod_entry, uint32_t mod_index);
     void process_event(const Event &e) override;
 
     Container *body_container = nullptr;
     Container *list_container = nullptr;
-    ScrollContainer *list_scroll_container = nullptr;
+    VirtualList *mod_list = nullptr;
     ModDetailsPanel *mod_details_panel = nullptr;
     Container *body_empty_container = nullptr;
     Container *footer_container = nullptr;
@@ -104,15 +97,15 @@ private:
     Button *refresh_button = nullptr;
     Button *mods_folder_button = nullptr;
     int32_t active_mod_index = -1;
-    std::vector<ModEntryButton *> mod_entry_buttons;
-    std::vector<ModEntrySpacer *> mod_entry_spacers;
-    std::vector<float> mod_entry_middles;
+    // Where navigating right from the selected mod entry goes, or nullptr if it doesn't go anywhere.
+    Element *mod_entry_nav_right = nullptr;
     ModEntryView *mod_entry_floating_view = nullptr;
     float mod_drag_start_coordinates[2] = {};
     float mod_drag_view_coordinates[2] = {};
     uint32_t mod_drag_target_index = 0;
     std::vector<recomp::mods::ModDetails> mod_details{};
-    std::unordered_set<std::string> loaded_thumbnails;
+    // Version of each mod that its thumbnail was loaded from, to detect when it changes.
+    std::unordered_map<std::string, ThumbnailCacheKey> loaded_thumbnails;
     std::string game_mod_id;
     bool mods_dirty = false;
     bool mod_scan_queued = false;
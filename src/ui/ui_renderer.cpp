@@ -3,10 +3,16 @@
 #define WIN32_LEAN_AND_MEAN
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <filesystem>
+#include <mutex>
+#include <thread>
 
 #include <concurrentqueue.h>
+#include <lightweightsemaphore.h>
 
 #include "rt64_render_hooks.h"
 #include "rt64_render_interface_builders.h"
@@ -17,6 +23,8 @@
 #include "ui_renderer.h"
 #include "runtime/support.hpp"
 
+#include "../../lib/rt64/src/contrib/stb/stb_image.h"
+
 #include "InterfaceVS.hlsl.spirv.h"
 #include "InterfacePS.hlsl.spirv.h"
 
@@ -66,6 +74,191 @@ struct TextureHandle {
     std::unique_ptr<RT64::RenderTexture> texture;
     std::unique_ptr<RT64::RenderDescriptorSet> set;
     bool transitioned = false;
+    // False until the copy that fills the texture has finished. The placeholder texture is drawn in its place until then.
+    bool uploaded = false;
+    // Textures packed into an atlas page have no texture or set of their own and are drawn with remapped UVs instead.
+    int atlas_page = -1;
+    Rml::Vector2f uv_offset{ 0.0f, 0.0f };
+    Rml::Vector2f uv_scale{ 1.0f, 1.0f };
+    // The padded rectangle the texture occupies in its atlas page, so it can be handed out again on release.
+    uint32_t atlas_x = 0;
+    uint32_t atlas_y = 0;
+    uint32_t atlas_width = 0;
+};
+
+// A shared texture that small UI images are packed into, so that drawing them doesn't require switching descriptor sets.
+// Space is handed out from shelves (rows). Each shelf keeps track of the spans released by its textures so they can be
+// handed out again, and empty shelves at the end of the page are dropped so their rows can be reused at any height.
+struct AtlasPage {
+    struct FreeSpan {
+        uint32_t x;
+        uint32_t width;
+    };
+
+    struct Shelf {
+        uint32_t y;
+        uint32_t height;
+        uint32_t x;
+        // Released spans before x, sorted by position. Adjacent spans are always merged.
+        std::vector<FreeSpan> free_spans;
+    };
+
+    std::unique_ptr<RT64::RenderTexture> texture;
+    std::unique_ptr<RT64::RenderDescriptorSet> set;
+    std::vector<Shelf> shelves;
+    uint32_t next_shelf_y = 0;
+    uint32_t texture_count = 0;
+    bool transitioned = false;
+
+    bool allocate(uint32_t page_size, uint32_t width, uint32_t height, uint32_t &x, uint32_t &y) {
+        // Use the shortest shelf that the image fits in, preferring the narrowest released span in it.
+        Shelf *best_shelf = nullptr;
+        int best_span = -1;
+        for (Shelf &shelf : shelves) {
+            if (height > shelf.height) {
+                continue;
+            }
+
+            int span_index = -1;
+            for (size_t i = 0; i < shelf.free_spans.size(); i++) {
+                const FreeSpan &span = shelf.free_spans[i];
+                if (span.width >= width && (span_index < 0 || span.width < shelf.free_spans[span_index].width)) {
+                    span_index = int(i);
+                }
+            }
+
+            if (span_index >= 0 || shelf.x + width <= page_size) {
+                if (best_shelf == nullptr || shelf.height < best_shelf->height) {
+                    best_shelf = &shelf;
+                    best_span = span_index;
+                }
+            }
+        }
+
+        // Start a new shelf if there's no good fit, to avoid wasting most of a tall shelf on a short image.
+        if ((best_shelf == nullptr || best_shelf->height > height * 2) && next_shelf_y + height <= page_size) {
+            shelves.emplace_back(Shelf{ next_shelf_y, height, 0 });
+            next_shelf_y += height;
+            best_shelf = &shelves.back();
+            best_span = -1;
+        }
+
+        if (best_shelf == nullptr) {
+            return false;
+        }
+
+        if (best_span >= 0) {
+            FreeSpan &span = best_shelf->free_spans[best_span];
+            x = span.x;
+            span.x += width;
+            span.width -= width;
+            if (span.width == 0) {
+                best_shelf->free_spans.erase(best_shelf->free_spans.begin() + best_span);
+            }
+        }
+        else {
+            x = best_shelf->x;
+            best_shelf->x += width;
+        }
+
+        y = best_shelf->y;
+        texture_count++;
+        return true;
+    }
+
+    void release(uint32_t x, uint32_t y, uint32_t width) {
+        assert(texture_count > 0);
+        texture_count--;
+        if (texture_count == 0) {
+            shelves.clear();
+            next_shelf_y = 0;
+            return;
+        }
+
+        auto shelf_it = std::find_if(shelves.begin(), shelves.end(), [y](const Shelf &shelf) { return shelf.y == y; });
+        assert(shelf_it != shelves.end());
+        Shelf &shelf = *shelf_it;
+
+        // Insert the span in order and merge it with its neighbors.
+        auto span_it = std::lower_bound(shelf.free_spans.begin(), shelf.free_spans.end(), x, [](const FreeSpan &span, uint32_t span_x) { return span.x < span_x; });
+        span_it = shelf.free_spans.insert(span_it, FreeSpan{ x, width });
+        auto next_it = span_it + 1;
+        if (next_it != shelf.free_spans.end() && span_it->x + span_it->width == next_it->x) {
+            span_it->width += next_it->width;
+            shelf.free_spans.erase(next_it);
+        }
+
+        if (span_it != shelf.free_spans.begin()) {
+            auto prev_it = span_it - 1;
+            if (prev_it->x + prev_it->width == span_it->x) {
+                prev_it->width += span_it->width;
+                shelf.free_spans.erase(span_it);
+                span_it = prev_it;
+            }
+        }
+
+        // Give the span back to the end of the shelf if nothing is allocated after it.
+        if (span_it->x + span_it->width == shelf.x) {
+            shelf.x = span_it->x;
+            shelf.free_spans.erase(span_it);
+        }
+
+        // Drop empty shelves at the end of the page so the rows can be used by shelves of a different height.
+        while (!shelves.empty() && shelves.back().x == 0) {
+            next_shelf_y = shelves.back().y;
+            shelves.pop_back();
+        }
+    }
+};
+
+// Large geometry compiled by RmlUi, kept in GPU buffers until RmlUi releases it.
+struct CompiledGeometry {
+    Rml::TextureHandle texture;
+    std::unique_ptr<RT64::RenderBuffer> vertex_buffer;
+    std::unique_ptr<RT64::RenderBuffer> index_buffer;
+    uint32_t num_vertices;
+    uint32_t num_indices;
+    // The copy into the GPU buffers is recorded at the start of the next frame. Until then the geometry is drawn
+    // from these CPU-side copies like uncompiled geometry.
+    bool uploaded = false;
+    std::unique_ptr<RT64::RenderBuffer> staging_buffer;
+    std::vector<Rml::Vertex> vertices;
+    std::vector<int> indices;
+};
+
+// A copy into an atlas page, recorded on the graphics command list at the start of the next frame so that it's ordered
+// with the draws that read from the page.
+struct AtlasUpload {
+    Rml::TextureHandle texture;
+    uint32_t page;
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+    uint32_t row_width;
+    std::unique_ptr<RT64::RenderBuffer> staging_buffer;
+};
+
+// Texture uploads recorded into a single copy command list and submitted together.
+struct UploadBatch {
+    std::vector<Rml::TextureHandle> textures;
+    std::vector<std::unique_ptr<RT64::RenderBuffer>> staging_buffers;
+    // Textures released while their upload was still pending, kept alive until the copy finishes.
+    std::vector<TextureHandle> released_textures;
+
+    bool empty() const {
+        return textures.empty() && staging_buffers.empty() && released_textures.empty();
+    }
+
+    bool contains(Rml::TextureHandle texture) const {
+        return std::find(textures.begin(), textures.end(), texture) != textures.end();
+    }
+
+    void clear() {
+        textures.clear();
+        staging_buffers.clear();
+        released_textures.clear();
+    }
 };
 
 template <typename T>
@@ -84,9 +277,42 @@ struct ImageFromBytes {
     uint32_t width;
     uint32_t height;
     std::string name;
-    std::vector<char> bytes;
+    std::vector<uint8_t> bytes;
 };
 
+// An image waiting to be decoded into RGBA32 by the decode workers (or by LoadTexture if it's needed first).
+struct ImageDecodeJob {
+    ImageFromBytes image;
+    // Set by whichever thread decodes the image.
+    std::atomic_bool claimed = false;
+    // Guarded by the decode mutex.
+    bool decoded = false;
+};
+
+static bool is_dds_file(const std::vector<uint8_t> &bytes) {
+    return bytes.size() >= 4 && memcmp(bytes.data(), "DDS ", 4) == 0;
+}
+
+// Decodes an image file into RGBA32 pixels in place. DDS files are left for RT64 to load since they may contain
+// block compressed data that can be uploaded as is. Images that fail to decode are also left as they are.
+static void decode_image(ImageFromBytes &image) {
+    if (image.type != ImageType::File || is_dds_file(image.bytes)) {
+        return;
+    }
+
+    int width, height, channels;
+    stbi_uc *pixels = stbi_load_from_memory(image.bytes.data(), int(image.bytes.size()), &width, &height, &channels, 4);
+    if (pixels == nullptr) {
+        return;
+    }
+
+    image.type = ImageType::RGBA32;
+    image.width = uint32_t(width);
+    image.height = uint32_t(height);
+    image.bytes.assign(pixels, pixels + size_t(width) * size_t(height) * 4);
+    stbi_image_free(pixels);
+}
+
 namespace recompui {
 class RmlRenderInterface_RT64_impl : public Rml::RenderInterfaceCompatibility {
     struct DynamicBuffer {
@@ -108,6 +334,15 @@ class RmlRenderInterface_RT64_impl : public Rml::RenderInterfaceCompatibility {
     static constexpr RT64::RenderFormat SwapChainFormat = RT64::RenderFormat::B8G8R8A8_UNORM;
     static constexpr uint32_t RmlTextureFormatBytesPerPixel = RenderFormatSize(RmlTextureFormat);
     static_assert(RenderFormatSize(RmlTextureFormatBgra) == RmlTextureFormatBytesPerPixel);
+    static constexpr uint32_t atlas_page_size = 2048;
+    // Images up to this size in both dimensions go into the atlas.
+    static constexpr uint32_t max_atlas_image_size = 256;
+    // Border of repeated edge pixels around each atlas image so that filtering doesn't bleed in neighboring images.
+    static constexpr uint32_t atlas_image_border = 1;
+    // Geometry with fewer vertices than this isn't compiled. Most text runs and boxes are far smaller, and copying them
+    // into the batched buffers every frame is cheaper than the separate draw and buffers that compiled geometry needs.
+    static constexpr int min_compiled_geometry_vertices = 1024;
+    static constexpr uint64_t frame_hash_seed = 0xCBF29CE484222325ULL;
     RT64::RenderInterface* interface_;
     RT64::RenderDevice* device_;
     int scissor_x_ = 0;
@@ -141,17 +376,53 @@ class RmlRenderInterface_RT64_impl : public Rml::RenderInterfaceCompatibility {
     std::unique_ptr<RT64::RenderBuffer> screen_vertex_buffer_{};
     std::unique_ptr<RT64::RenderCommandQueue> copy_command_queue_{};
     std::unique_ptr<RT64::RenderCommandList> copy_command_list_{};
-    std::unique_ptr<RT64::RenderBuffer> copy_buffer_{};
     std::unique_ptr<RT64::RenderCommandFence> copy_command_fence_;
-    uint64_t copy_buffer_size_ = 0;
+    // Uploads being recorded for this frame and the ones submitted at the end of the previous frame.
+    UploadBatch recording_uploads_{};
+    UploadBatch submitted_uploads_{};
+    bool copy_command_list_open_ = false;
+    std::vector<AtlasPage> atlas_pages_{};
+    std::vector<AtlasUpload> atlas_uploads_{};
+    const RT64::RenderDescriptorSet *bound_texture_set_ = nullptr;
+    // Consecutive geometry with the same texture and scissor is merged into a single draw.
+    struct GeometryBatch {
+        Rml::TextureHandle texture = 0;
+        const RT64::RenderDescriptorSet *texture_set = nullptr;
+        RT64::RenderRect scissor{};
+        uint32_t vertex_buffer_offset = 0;
+        uint32_t index_buffer_offset = 0;
+        uint32_t num_vertices = 0;
+        uint32_t num_indices = 0;
+    } batch_;
+    std::unordered_map<Rml::CompiledGeometryHandle, CompiledGeometry> compiled_geometry_{};
+    Rml::CompiledGeometryHandle compiled_geometry_count_ = 1;
+    std::vector<Rml::CompiledGeometryHandle> geometry_uploads_{};
+    // Hash of everything drawn since start(), used to tell whether a frame looks any different from the last one.
+    uint64_t frame_hash_ = 0;
+    // Whether the placeholder was drawn this frame in place of a texture that was still uploading.
+    bool frame_used_placeholder_ = false;
+    // Whether this frame is being rendered into screen_texture_ rather than straight to the swap chain.
+    bool render_to_texture_ = false;
+    // Whether screen_texture_ holds a complete frame that can be composited again, and that frame's hash.
+    bool cached_frame_valid_ = false;
+    uint64_t cached_frame_hash_ = 0;
+    // Set between begin_frame_check and end_frame_check, where geometry is only hashed and not drawn.
+    bool hash_only_ = false;
     uint64_t screen_vertex_buffer_size_ = 0;
     uint32_t gTexture_descriptor_index;
     RT64::RenderInputSlot vertex_slot_{ 0, sizeof(Rml::Vertex) };
     RT64::RenderCommandList* list_ = nullptr;
     bool scissor_enabled_ = false;
     std::vector<std::unique_ptr<RT64::RenderBuffer>> stale_buffers_{};
-    moodycamel::ConcurrentQueue<ImageFromBytes> image_from_bytes_queue;
-    std::unordered_map<std::string, ImageFromBytes> image_from_bytes_map;
+    moodycamel::ConcurrentQueue<std::shared_ptr<ImageDecodeJob>> image_from_bytes_queue;
+    std::unordered_map<std::string, std::shared_ptr<ImageDecodeJob>> image_from_bytes_map;
+    // Worker pool that decodes queued image files ahead of LoadTexture.
+    std::vector<std::thread> decode_threads_;
+    std::atomic_bool decode_threads_running_ = true;
+    moodycamel::ConcurrentQueue<std::shared_ptr<ImageDecodeJob>> decode_queue_;
+    moodycamel::LightweightSemaphore decode_signal_;
+    std::mutex decode_mutex_;
+    std::condition_variable decode_done_cv_;
 public:
     RmlRenderInterface_RT64_impl(RT64::RenderInterface* interface, RT64::RenderDevice* device) {
         interface_ = interface;
@@ -254,25 +525,133 @@ public:
         if (multisampling_.sampleCount > 1) {
             pipeline_desc.multisampling = multisampling_;
             pipeline_ms_ = device_->createGraphicsPipeline(pipeline_desc);
-
-            // Create the descriptor set for the screen drawer.
-            RT64::RenderDescriptorRange screen_descriptor_range(RT64::RenderDescriptorRangeType::TEXTURE, 2, 1);
-            screen_descriptor_set_ = device_->createDescriptorSet(RT64::RenderDescriptorSetDesc(&screen_descriptor_range, 1));
-
-            // Create vertex buffer for the screen drawer (full-screen triangle).
-            screen_vertex_buffer_size_ = sizeof(Rml::Vertex) * 3;
-            screen_vertex_buffer_ = device_->createBuffer(RT64::RenderBufferDesc::VertexBuffer(screen_vertex_buffer_size_, RT64::RenderHeapType::UPLOAD));
-            Rml::Vertex *vertices = (Rml::Vertex *)(screen_vertex_buffer_->map());
-            const Rml::ColourbPremultiplied white(255, 255, 255, 255);
-            vertices[0] = Rml::Vertex{ Rml::Vector2f(-1.0f, 1.0f), white, Rml::Vector2f(0.0f, 0.0f) };
-            vertices[1] = Rml::Vertex{ Rml::Vector2f(-1.0f, -3.0f), white, Rml::Vector2f(0.0f, 2.0f) };
-            vertices[2] = Rml::Vertex{ Rml::Vector2f(3.0f, 1.0f), white, Rml::Vector2f(2.0f, 0.0f) };
-            screen_vertex_buffer_->unmap();
         }
 
+        // The UI is always rendered into screen_texture_ so that an unchanged frame can be drawn again without
+        // re-rendering it. Create the descriptor set for the screen drawer.
+        RT64::RenderDescriptorRange screen_descriptor_range(RT64::RenderDescriptorRangeType::TEXTURE, 2, 1);
+        screen_descriptor_set_ = device_->createDescriptorSet(RT64::RenderDescriptorSetDesc(&screen_descriptor_range, 1));
+
+        // Create vertex buffer for the screen drawer (full-screen triangle).
+        screen_vertex_buffer_size_ = sizeof(Rml::Vertex) * 3;
+        screen_vertex_buffer_ = device_->createBuffer(RT64::RenderBufferDesc::VertexBuffer(screen_vertex_buffer_size_, RT64::RenderHeapType::UPLOAD));
+        Rml::Vertex *vertices = (Rml::Vertex *)(screen_vertex_buffer_->map());
+        const Rml::ColourbPremultiplied white(255, 255, 255, 255);
+        vertices[0] = Rml::Vertex{ Rml::Vector2f(-1.0f, 1.0f), white, Rml::Vector2f(0.0f, 0.0f) };
+        vertices[1] = Rml::Vertex{ Rml::Vector2f(-1.0f, -3.0f), white, Rml::Vector2f(0.0f, 2.0f) };
+        vertices[2] = Rml::Vertex{ Rml::Vector2f(3.0f, 1.0f), white, Rml::Vector2f(2.0f, 0.0f) };
+        screen_vertex_buffer_->unmap();
+
         copy_command_queue_ = device->createCommandQueue(RT64::RenderCommandListType::COPY);
         copy_command_list_ = copy_command_queue_->createCommandList(RT64::RenderCommandListType::COPY);
         copy_command_fence_ = device->createCommandFence();
+
+        // Create the reserved textures up front, since texture #1 is drawn in place of textures that are still uploading.
+        Rml::byte white_pixel[] = { 255, 255, 255, 255 };
+        create_texture(0, white_pixel, Rml::Vector2i{ 1, 1 });
+        Rml::byte transparent_pixel[] = { 0, 0, 0, 0 };
+        create_texture(1, transparent_pixel, Rml::Vector2i{ 1, 1 });
+        submit_uploads();
+        finish_uploads();
+
+        uint32_t decode_thread_count = std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U);
+        for (uint32_t i = 0; i < decode_thread_count; i++) {
+            decode_threads_.emplace_back(&RmlRenderInterface_RT64_impl::decode_thread_func, this);
+        }
+    }
+
+    ~RmlRenderInterface_RT64_impl() {
+        decode_threads_running_ = false;
+        decode_signal_.signal(int(decode_threads_.size()));
+        for (std::thread &thread : decode_threads_) {
+            thread.join();
+        }
+
+        submit_uploads();
+        finish_uploads();
+    }
+
+    void decode_thread_func() {
+        while (true) {
+            decode_signal_.wait();
+            if (!decode_threads_running_) {
+                break;
+            }
+
+            std::shared_ptr<ImageDecodeJob> job;
+            if (decode_queue_.try_dequeue(job)) {
+                run_decode_job(*job);
+            }
+        }
+    }
+
+    // Decodes the job's image unless another thread already claimed it.
+    void run_decode_job(ImageDecodeJob &job) {
+        if (job.claimed.exchange(true)) {
+            return;
+        }
+
+        decode_image(job.image);
+
+        {
+            std::lock_guard lock{ decode_mutex_ };
+            job.decoded = true;
+        }
+        decode_done_cv_.notify_all();
+    }
+
+    // Returns once the job's image has been decoded, decoding it on this thread if no worker has started on it yet.
+    void wait_for_decode(ImageDecodeJob &job) {
+        run_decode_job(job);
+
+        std::unique_lock lock{ decode_mutex_ };
+        decode_done_cv_.wait(lock, [&job]() { return job.decoded; });
+    }
+
+    // Returns the copy command list to record an upload into, starting a new batch if needed.
+    RT64::RenderCommandList *begin_upload() {
+        if (!copy_command_list_open_) {
+            // The command list can't be reset while the previous batch is still executing. This normally already
+            // happened at the start of the frame.
+            finish_uploads();
+            copy_command_list_->begin();
+            copy_command_list_open_ = true;
+        }
+
+        return copy_command_list_.get();
+    }
+
+    // Submits every upload recorded so far without waiting for them.
+    void submit_uploads() {
+        if (!copy_command_list_open_) {
+            return;
+        }
+
+        finish_uploads();
+
+        copy_command_list_->end();
+        copy_command_queue_->executeCommandLists(copy_command_list_.get(), copy_command_fence_.get());
+        copy_command_list_open_ = false;
+        std::swap(recording_uploads_, submitted_uploads_);
+    }
+
+    // Waits for the submitted batch and marks its textures as ready to draw. Called a frame after submission,
+    // by which point the copy has almost always finished already.
+    void finish_uploads() {
+        if (submitted_uploads_.empty()) {
+            return;
+        }
+
+        copy_command_queue_->waitForCommandFence(copy_command_fence_.get());
+
+        for (Rml::TextureHandle texture : submitted_uploads_.textures) {
+            auto it = textures_.find(texture);
+            if (it != textures_.end()) {
+                it->second.uploaded = true;
+            }
+        }
+
+        submitted_uploads_.clear();
     }
 
     void reset_dynamic_buffer(DynamicBuffer &dynamic_buffer) {
@@ -346,54 +725,223 @@ public:
         return allocate_dynamic_data(dynamic_buffer, padding_bytes + num_bytes) + padding_bytes;
     }
     
-    void RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture, const Rml::Vector2f& translation) override {
-        if (!textures_.contains(texture)) {
-            if (texture == 0) {
-                Rml::byte white_pixel[] = { 255, 255, 255, 255 };
-                create_texture(0, white_pixel, Rml::Vector2i{ 1, 1 });
-            }
-            else if (texture == 1) {
-                Rml::byte transparent_pixel[] = { 0, 0, 0, 0 };
-                create_texture(1, transparent_pixel, Rml::Vector2i{ 1, 1 });
-            }
-            else {
-                assert(false && "Rendered without texture!");
+    // Resolves the texture to draw for a handle, which is the placeholder if the texture is still uploading or was released.
+    TextureHandle &resolve_texture(Rml::TextureHandle texture) {
+        auto it = textures_.find(texture);
+        if (it == textures_.end() || !it->second.uploaded) {
+            if (it != textures_.end()) {
+                frame_used_placeholder_ = true;
             }
+            return textures_.at(1);
         }
+        return it->second;
+    }
 
-        // Copy the vertex and index data into the mapped buffers.
-        uint32_t vert_size_bytes = num_vertices * sizeof(*vertices);
-        uint32_t index_size_bytes = num_indices * sizeof(*indices);
-        uint32_t vertex_buffer_offset = allocate_dynamic_data(vertex_buffer_, vert_size_bytes);
-        uint32_t index_buffer_offset = allocate_dynamic_data(index_buffer_, index_size_bytes);
-        memcpy(vertex_buffer_.mapped_data_ + vertex_buffer_offset, vertices, vert_size_bytes);
-        memcpy(index_buffer_.mapped_data_ + index_buffer_offset, indices, index_size_bytes);
+    // FNV-1a over the given bytes, folded into the frame hash.
+    void hash_frame_data(const void *data, size_t size) {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data);
+        uint64_t hash = frame_hash_;
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+        }
+        frame_hash_ = hash;
+    }
 
-        list_->setViewports(RT64::RenderViewport{ 0, 0, float(window_width_), float(window_height_) });
+    template <typename T>
+    void hash_frame_value(const T &value) {
+        hash_frame_data(&value, sizeof(T));
+    }
+
+    static const RT64::RenderDescriptorSet *get_texture_set(const TextureHandle &texture_handle, const std::vector<AtlasPage> &atlas_pages) {
+        return texture_handle.atlas_page >= 0 ? atlas_pages[texture_handle.atlas_page].set.get() : texture_handle.set.get();
+    }
+
+    RT64::RenderRect get_scissor_rect() const {
         if (scissor_enabled_) {
-            list_->setScissors(RT64::RenderRect{
+            return RT64::RenderRect{
                 scissor_x_,
                 scissor_y_,
                 (scissor_width_ + scissor_x_),
-                (scissor_height_ + scissor_y_) });
+                (scissor_height_ + scissor_y_) };
         }
         else {
-            list_->setScissors(RT64::RenderRect{ 0, 0, window_width_, window_height_ });
+            return RT64::RenderRect{ 0, 0, window_width_, window_height_ };
         }
+    }
+
+    void RenderGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture, const Rml::Vector2f& translation) override {
+        assert(textures_.contains(texture) && "Rendered without texture!");
+
+        TextureHandle &texture_handle = resolve_texture(texture);
+        const RT64::RenderDescriptorSet *texture_set = get_texture_set(texture_handle, atlas_pages_);
+        RT64::RenderRect scissor = get_scissor_rect();
+
+        uint32_t vert_size_bytes = num_vertices * sizeof(*vertices);
+        uint32_t index_size_bytes = num_indices * sizeof(*indices);
+
+        hash_frame_value(texture);
+        hash_frame_value(translation);
+        hash_frame_value(scissor);
+        hash_frame_data(vertices, vert_size_bytes);
+        hash_frame_data(indices, index_size_bytes);
+        if (hash_only_) {
+            return;
+        }
+
+        // Geometry can only be appended to the current batch if it uses the same state and fits in the remaining space
+        // of the current buffers, since a resize would move it into a different buffer.
+        if (batch_.num_indices > 0) {
+            bool same_state = batch_.texture_set == texture_set &&
+                batch_.scissor.left == scissor.left && batch_.scissor.top == scissor.top &&
+                batch_.scissor.right == scissor.right && batch_.scissor.bottom == scissor.bottom;
+            bool fits = vertex_buffer_.bytes_used_ + vert_size_bytes <= vertex_buffer_.size_ &&
+                index_buffer_.bytes_used_ + index_size_bytes <= index_buffer_.size_;
+            if (!same_state || !fits) {
+                flush_batch();
+            }
+        }
+
+        // Copy the vertex and index data into the mapped buffers.
+        uint32_t vertex_buffer_offset = allocate_dynamic_data(vertex_buffer_, vert_size_bytes);
+        uint32_t index_buffer_offset = allocate_dynamic_data(index_buffer_, index_size_bytes);
 
-        RT64::RenderIndexBufferView index_view{index_buffer_.buffer_->at(index_buffer_offset), index_size_bytes, RT64::RenderFormat::R32_UINT};
+        if (batch_.num_indices == 0) {
+            batch_.texture = texture;
+            batch_.texture_set = texture_set;
+            batch_.scissor = scissor;
+            batch_.vertex_buffer_offset = vertex_buffer_offset;
+            batch_.index_buffer_offset = index_buffer_offset;
+            batch_.num_vertices = 0;
+        }
+
+        // The translation is applied here rather than in the shader so that geometry with different translations can
+        // be drawn together. Atlas images also get their texture coordinates remapped into their area of the page.
+        Rml::Vertex *dst_vertices = reinterpret_cast<Rml::Vertex *>(vertex_buffer_.mapped_data_ + vertex_buffer_offset);
+        bool is_atlas = texture_handle.atlas_page >= 0;
+        for (int i = 0; i < num_vertices; i++) {
+            dst_vertices[i] = vertices[i];
+            dst_vertices[i].position += translation;
+            if (is_atlas) {
+                dst_vertices[i].tex_coord = texture_handle.uv_offset + vertices[i].tex_coord * texture_handle.uv_scale;
+            }
+        }
+
+        // Rebase the indices onto the start of the batch.
+        int *dst_indices = reinterpret_cast<int *>(index_buffer_.mapped_data_ + index_buffer_offset);
+        for (int i = 0; i < num_indices; i++) {
+            dst_indices[i] = indices[i] + int(batch_.num_vertices);
+        }
+
+        batch_.num_vertices += num_vertices;
+        batch_.num_indices += num_indices;
+    }
+
+    // Draws all of the geometry accumulated since the last flush.
+    void flush_batch() {
+        if (batch_.num_indices == 0) {
+            return;
+        }
+
+        list_->setViewports(RT64::RenderViewport{ 0, 0, float(window_width_), float(window_height_) });
+        list_->setScissors(batch_.scissor);
+
+        uint32_t vert_size_bytes = batch_.num_vertices * sizeof(Rml::Vertex);
+        uint32_t index_size_bytes = batch_.num_indices * sizeof(int);
+        RT64::RenderIndexBufferView index_view{index_buffer_.buffer_->at(batch_.index_buffer_offset), index_size_bytes, RT64::RenderFormat::R32_UINT};
         list_->setIndexBuffer(&index_view);
-        RT64::RenderVertexBufferView vertex_view{vertex_buffer_.buffer_->at(vertex_buffer_offset), vert_size_bytes};
+        RT64::RenderVertexBufferView vertex_view{vertex_buffer_.buffer_->at(batch_.vertex_buffer_offset), vert_size_bytes};
         list_->setVertexBuffers(0, &vertex_view, 1, &vertex_slot_);
 
-        TextureHandle &texture_handle = textures_.at(texture);
-        if (!texture_handle.transitioned) {
-            // Prepare the texture for being read from a pixel shader.
-            list_->barriers(RT64::RenderBarrierStage::GRAPHICS, RT64::RenderTextureBarrier(texture_handle.texture.get(), RT64::RenderTextureLayout::SHADER_READ));
-            texture_handle.transitioned = true;
+        bind_texture(resolve_texture(batch_.texture));
+
+        RmlPushConstants constants{
+            .transform = mvp_,
+            .translation = Rml::Vector2f(0.0f, 0.0f)
+        };
+
+        list_->setGraphicsPushConstants(0, &constants);
+
+        list_->drawIndexedInstanced(batch_.num_indices, 1, 0, 0, 0);
+
+        batch_.num_vertices = 0;
+        batch_.num_indices = 0;
+    }
+
+    Rml::CompiledGeometryHandle CompileGeometry(Rml::Vertex* vertices, int num_vertices, int* indices, int num_indices, Rml::TextureHandle texture) override {
+        // RmlUi falls back to RenderGeometry for anything that isn't compiled.
+        if (num_vertices < min_compiled_geometry_vertices || num_indices <= 0 || !textures_.contains(texture)) {
+            return 0;
+        }
+
+        uint32_t vert_size_bytes = num_vertices * sizeof(*vertices);
+        uint32_t index_size_bytes = num_indices * sizeof(*indices);
+
+        CompiledGeometry geometry{};
+        geometry.texture = texture;
+        geometry.num_vertices = uint32_t(num_vertices);
+        geometry.num_indices = uint32_t(num_indices);
+        geometry.vertex_buffer = device_->createBuffer(RT64::RenderBufferDesc::VertexBuffer(vert_size_bytes, RT64::RenderHeapType::DEFAULT));
+        geometry.index_buffer = device_->createBuffer(RT64::RenderBufferDesc::IndexBuffer(index_size_bytes, RT64::RenderHeapType::DEFAULT));
+        geometry.staging_buffer = device_->createBuffer(RT64::RenderBufferDesc::UploadBuffer(vert_size_bytes + index_size_bytes));
+        if (geometry.vertex_buffer == nullptr || geometry.index_buffer == nullptr || geometry.staging_buffer == nullptr) {
+            return 0;
+        }
+
+        // Fill the staging buffer with the vertices followed by the indices. The texture coordinates of atlas images are
+        // remapped now, since the texture can't change.
+        const TextureHandle &texture_handle = textures_.at(texture);
+        uint8_t *staging_data = reinterpret_cast<uint8_t *>(geometry.staging_buffer->map());
+        Rml::Vertex *dst_vertices = reinterpret_cast<Rml::Vertex *>(staging_data);
+        for (int i = 0; i < num_vertices; i++) {
+            dst_vertices[i] = vertices[i];
+            if (texture_handle.atlas_page >= 0) {
+                dst_vertices[i].tex_coord = texture_handle.uv_offset + vertices[i].tex_coord * texture_handle.uv_scale;
+            }
+        }
+        memcpy(staging_data + vert_size_bytes, indices, index_size_bytes);
+        geometry.staging_buffer->unmap();
+
+        geometry.vertices.assign(vertices, vertices + num_vertices);
+        geometry.indices.assign(indices, indices + num_indices);
+
+        Rml::CompiledGeometryHandle handle = compiled_geometry_count_++;
+        compiled_geometry_.emplace(handle, std::move(geometry));
+        geometry_uploads_.push_back(handle);
+
+        return handle;
+    }
+
+    void RenderCompiledGeometry(Rml::CompiledGeometryHandle handle, const Rml::Vector2f& translation) override {
+        auto it = compiled_geometry_.find(handle);
+        if (it == compiled_geometry_.end()) {
+            return;
+        }
+
+        hash_frame_value(handle);
+        hash_frame_value(translation);
+        hash_frame_value(get_scissor_rect());
+        if (hash_only_) {
+            return;
+        }
+
+        CompiledGeometry &geometry = it->second;
+        if (!geometry.uploaded) {
+            RenderGeometry(geometry.vertices.data(), int(geometry.num_vertices), geometry.indices.data(), int(geometry.num_indices), geometry.texture, translation);
+            return;
         }
 
-        list_->setGraphicsDescriptorSet(texture_handle.set.get(), 1);
+        // Compiled geometry lives in its own buffers, so it can't be merged with the current batch.
+        flush_batch();
+
+        list_->setViewports(RT64::RenderViewport{ 0, 0, float(window_width_), float(window_height_) });
+        list_->setScissors(get_scissor_rect());
+
+        RT64::RenderIndexBufferView index_view{geometry.index_buffer.get(), geometry.num_indices * uint32_t(sizeof(int)), RT64::RenderFormat::R32_UINT};
+        list_->setIndexBuffer(&index_view);
+        RT64::RenderVertexBufferView vertex_view{geometry.vertex_buffer.get(), geometry.num_vertices * uint32_t(sizeof(Rml::Vertex))};
+        list_->setVertexBuffers(0, &vertex_view, 1, &vertex_slot_);
+
+        bind_texture(resolve_texture(geometry.texture));
 
         RmlPushConstants constants{
             .transform = mvp_,
@@ -402,7 +950,201 @@ public:
 
         list_->setGraphicsPushConstants(0, &constants);
 
-        list_->drawIndexedInstanced(num_indices, 1, 0, 0, 0);
+        list_->drawIndexedInstanced(geometry.num_indices, 1, 0, 0, 0);
+    }
+
+    void ReleaseCompiledGeometry(Rml::CompiledGeometryHandle handle) override {
+        auto it = compiled_geometry_.find(handle);
+        if (it == compiled_geometry_.end()) {
+            return;
+        }
+
+        // The buffers may still be used by this frame's command list, so let them persist until the start of next frame.
+        CompiledGeometry &geometry = it->second;
+        stale_buffers_.emplace_back(std::move(geometry.vertex_buffer));
+        stale_buffers_.emplace_back(std::move(geometry.index_buffer));
+        if (geometry.staging_buffer != nullptr) {
+            stale_buffers_.emplace_back(std::move(geometry.staging_buffer));
+        }
+
+        std::erase(geometry_uploads_, handle);
+        compiled_geometry_.erase(it);
+    }
+
+    // Records the copies into the GPU buffers of geometry compiled since the last frame.
+    void flush_geometry_uploads() {
+        if (geometry_uploads_.empty()) {
+            return;
+        }
+
+        std::vector<RT64::RenderBufferBarrier> barriers;
+        for (Rml::CompiledGeometryHandle handle : geometry_uploads_) {
+            CompiledGeometry &geometry = compiled_geometry_.at(handle);
+            barriers.emplace_back(RT64::RenderBufferBarrier(geometry.vertex_buffer.get(), RT64::RenderBufferAccess::WRITE));
+            barriers.emplace_back(RT64::RenderBufferBarrier(geometry.index_buffer.get(), RT64::RenderBufferAccess::WRITE));
+        }
+        list_->barriers(RT64::RenderBarrierStage::COPY, barriers.data(), uint32_t(barriers.size()));
+
+        for (Rml::CompiledGeometryHandle handle : geometry_uploads_) {
+            CompiledGeometry &geometry = compiled_geometry_.at(handle);
+            uint32_t vert_size_bytes = geometry.num_vertices * sizeof(Rml::Vertex);
+            uint32_t index_size_bytes = geometry.num_indices * sizeof(int);
+            list_->copyBufferRegion(geometry.vertex_buffer->at(0), geometry.staging_buffer->at(0), vert_size_bytes);
+            list_->copyBufferRegion(geometry.index_buffer->at(0), geometry.staging_buffer->at(vert_size_bytes), index_size_bytes);
+
+            // The staging buffer has to persist until this frame's command list has executed.
+            stale_buffers_.emplace_back(std::move(geometry.staging_buffer));
+            geometry.vertices = {};
+            geometry.indices = {};
+            geometry.uploaded = true;
+        }
+
+        barriers.clear();
+        for (Rml::CompiledGeometryHandle handle : geometry_uploads_) {
+            CompiledGeometry &geometry = compiled_geometry_.at(handle);
+            barriers.emplace_back(RT64::RenderBufferBarrier(geometry.vertex_buffer.get(), RT64::RenderBufferAccess::READ));
+            barriers.emplace_back(RT64::RenderBufferBarrier(geometry.index_buffer.get(), RT64::RenderBufferAccess::READ));
+        }
+        list_->barriers(RT64::RenderBarrierStage::GRAPHICS, barriers.data(), uint32_t(barriers.size()));
+
+        geometry_uploads_.clear();
+    }
+
+    void bind_texture(TextureHandle &texture_handle) {
+        RT64::RenderTexture *texture = texture_handle.texture.get();
+        RT64::RenderDescriptorSet *set = texture_handle.set.get();
+        bool *transitioned = &texture_handle.transitioned;
+        if (texture_handle.atlas_page >= 0) {
+            AtlasPage &page = atlas_pages_[texture_handle.atlas_page];
+            texture = page.texture.get();
+            set = page.set.get();
+            transitioned = &page.transitioned;
+        }
+
+        if (!*transitioned) {
+            // Prepare the texture for being read from a pixel shader.
+            list_->barriers(RT64::RenderBarrierStage::GRAPHICS, RT64::RenderTextureBarrier(texture, RT64::RenderTextureLayout::SHADER_READ));
+            *transitioned = true;
+        }
+
+        // Consecutive draws from the same texture or atlas page don't need to rebind it.
+        if (set != bound_texture_set_) {
+            list_->setGraphicsDescriptorSet(set, 1);
+            bound_texture_set_ = set;
+        }
+    }
+
+    static bool fits_in_atlas(const Rml::Vector2i &dimensions) {
+        return uint32_t(dimensions.x) <= max_atlas_image_size && uint32_t(dimensions.y) <= max_atlas_image_size;
+    }
+
+    // Packs an RGBA image into an atlas page. The copy itself is recorded at the start of the next frame.
+    bool create_atlas_texture(Rml::TextureHandle texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions, bool flip_y) {
+        uint32_t width = source_dimensions.x;
+        uint32_t height = source_dimensions.y;
+        uint32_t padded_width = width + atlas_image_border * 2;
+        uint32_t padded_height = height + atlas_image_border * 2;
+
+        uint32_t page_index = 0;
+        uint32_t x = 0, y = 0;
+        while (page_index < atlas_pages_.size() && !atlas_pages_[page_index].allocate(atlas_page_size, padded_width, padded_height, x, y)) {
+            page_index++;
+        }
+
+        if (page_index == atlas_pages_.size()) {
+            AtlasPage page{};
+            page.texture = device_->createTexture(RT64::RenderTextureDesc::Texture2D(atlas_page_size, atlas_page_size, 1, RmlTextureFormat));
+            if (page.texture == nullptr) {
+                return false;
+            }
+
+            page.set = texture_set_builder_->create(device_);
+            page.set->setTexture(gTexture_descriptor_index, page.texture.get(), RT64::RenderTextureLayout::SHADER_READ);
+            page.allocate(atlas_page_size, padded_width, padded_height, x, y);
+            atlas_pages_.emplace_back(std::move(page));
+        }
+
+        // Write the image into a staging buffer along with a border of repeated edge pixels.
+        uint32_t row_pitch = width * RmlTextureFormatBytesPerPixel;
+        uint32_t row_byte_width, row_byte_padding;
+        CalculateTextureRowWidthPadding(padded_width * RmlTextureFormatBytesPerPixel, row_byte_width, row_byte_padding);
+        std::unique_ptr<RT64::RenderBuffer> staging_buffer = device_->createBuffer(RT64::RenderBufferDesc::UploadBuffer(row_byte_width * padded_height));
+
+        uint8_t* dst_data = (uint8_t *)(staging_buffer->map());
+        for (uint32_t dst_row = 0; dst_row < padded_height; dst_row++) {
+            uint32_t src_row = std::clamp<int32_t>(int32_t(dst_row) - int32_t(atlas_image_border), 0, int32_t(height) - 1);
+            if (flip_y) {
+                src_row = height - src_row - 1;
+            }
+
+            const Rml::byte *src_row_data = source + row_pitch * src_row;
+            uint8_t *dst_row_data = dst_data + row_byte_width * dst_row;
+            for (uint32_t i = 0; i < atlas_image_border; i++) {
+                memcpy(dst_row_data + i * RmlTextureFormatBytesPerPixel, src_row_data, RmlTextureFormatBytesPerPixel);
+                memcpy(dst_row_data + (atlas_image_border + width + i) * RmlTextureFormatBytesPerPixel, src_row_data + row_pitch - RmlTextureFormatBytesPerPixel, RmlTextureFormatBytesPerPixel);
+            }
+            memcpy(dst_row_data + atlas_image_border * RmlTextureFormatBytesPerPixel, src_row_data, row_pitch);
+        }
+        staging_buffer->unmap();
+
+        atlas_uploads_.emplace_back(AtlasUpload{
+            .texture = texture_handle,
+            .page = page_index,
+            .x = x,
+            .y = y,
+            .width = padded_width,
+            .height = padded_height,
+            .row_width = row_byte_width / RmlTextureFormatBytesPerPixel,
+            .staging_buffer = std::move(staging_buffer)
+        });
+
+        TextureHandle handle{};
+        handle.atlas_page = int(page_index);
+        handle.atlas_x = x;
+        handle.atlas_y = y;
+        handle.atlas_width = padded_width;
+        handle.uv_offset = Rml::Vector2f(float(x + atlas_image_border), float(y + atlas_image_border)) / float(atlas_page_size);
+        handle.uv_scale = Rml::Vector2f(float(width), float(height)) / float(atlas_page_size);
+        textures_.emplace(texture_handle, std::move(handle));
+
+        return true;
+    }
+
+    // Records the copies for every image packed into the atlas since the last frame.
+    void flush_atlas_uploads() {
+        if (atlas_uploads_.empty()) {
+            return;
+        }
+
+        // Prepare every page being copied into, they get transitioned back when they're next drawn from.
+        std::vector<bool> page_copied(atlas_pages_.size(), false);
+        std::vector<RT64::RenderTextureBarrier> copy_barriers;
+        for (const AtlasUpload &upload : atlas_uploads_) {
+            if (!page_copied[upload.page]) {
+                AtlasPage &page = atlas_pages_[upload.page];
+                copy_barriers.emplace_back(RT64::RenderTextureBarrier(page.texture.get(), RT64::RenderTextureLayout::COPY_DEST));
+                page.transitioned = false;
+                page_copied[upload.page] = true;
+            }
+        }
+        list_->barriers(RT64::RenderBarrierStage::COPY, copy_barriers.data(), uint32_t(copy_barriers.size()));
+
+        for (AtlasUpload &upload : atlas_uploads_) {
+            list_->copyTextureRegion(
+                RT64::RenderTextureCopyLocation::Subresource(atlas_pages_[upload.page].texture.get()),
+                RT64::RenderTextureCopyLocation::PlacedFootprint(upload.staging_buffer.get(), RmlTextureFormat, upload.width, upload.height, 1, upload.row_width),
+                upload.x, upload.y);
+
+            auto it = textures_.find(upload.texture);
+            if (it != textures_.end()) {
+                it->second.uploaded = true;
+            }
+
+            // The staging buffer has to persist until this frame's command list has executed.
+            stale_buffers_.emplace_back(std::move(upload.staging_buffer));
+        }
+
+        atlas_uploads_.clear();
     }
 
     void EnableScissorRegion(bool enable) override {
@@ -434,33 +1176,34 @@ public:
             return true;
         }
         
+        // Normally the decode workers are already done with the image by the time it's loaded.
+        wait_for_decode(*it->second);
+
         RT64::Texture* texture = nullptr;
         std::unique_ptr<RT64::RenderBuffer> texture_buffer;
-        ImageFromBytes& img = it->second;
-        copy_command_list_->begin();
-
-        switch (img.type) {
-            case ImageType::RGBA32:
-                {
-                    // Read the image header (two 32-bit values for width and height respectively).
-                    uint32_t rowPitch = img.width * 4;
-                    size_t byteCount = img.height * rowPitch;
-                    texture = new RT64::Texture();
-                    RT64::TextureCache::setRGBA32(texture, device_, copy_command_list_.get(), reinterpret_cast<const uint8_t*>(img.bytes.data()), byteCount, img.width, img.height, rowPitch, texture_buffer, nullptr);
-                }
-                break;
-            case ImageType::File:
-                {
-                    // TODO: This data copy can be avoided when RT64::TextureCache::loadTextureFromBytes's function is updated to only take a pointer and size as the input.
-                    std::vector<uint8_t> data_copy(img.bytes.data(), img.bytes.data() + img.bytes.size());
-                    texture = RT64::TextureCache::loadTextureFromBytes(device_, copy_command_list_.get(), data_copy, texture_buffer);
-                }
-                break;
+        ImageFromBytes& img = it->second->image;
+
+        if (img.type == ImageType::RGBA32) {
+            Rml::Vector2i dimensions{ int(img.width), int(img.height) };
+            Rml::TextureHandle new_handle = texture_count_++;
+            if (!create_texture(new_handle, img.bytes.data(), dimensions)) {
+                return false;
+            }
+
+            texture_handle = new_handle;
+            texture_dimensions = dimensions;
+            return true;
+        }
+
+        RT64::RenderCommandList *upload_list = begin_upload();
+
+        // Only DDS files (or images stb_image couldn't decode) are still in file form at this point.
+        texture = RT64::TextureCache::loadTextureFromBytes(device_, upload_list, img.bytes, texture_buffer);
+
+        // The staging buffer has to outlive the copy.
+        if (texture_buffer != nullptr) {
+            recording_uploads_.staging_buffers.emplace_back(std::move(texture_buffer));
         }
-        
-        copy_command_list_->end();
-        copy_command_queue_->executeCommandLists(copy_command_list_.get(), copy_command_fence_.get());
-        copy_command_queue_->waitForCommandFence(copy_command_fence_.get());
 
         if (texture == nullptr) {
             return false;
@@ -472,7 +1215,8 @@ public:
 
         std::unique_ptr<RT64::RenderDescriptorSet> set = texture_set_builder_->create(device_);
         set->setTexture(gTexture_descriptor_index, texture->texture.get(), RT64::RenderTextureLayout::SHADER_READ);
-        textures_.emplace(texture_handle, TextureHandle{ std::move(texture->texture), std::move(set), false });
+        textures_.emplace(texture_handle, TextureHandle{ std::move(texture->texture), std::move(set), false, false });
+        recording_uploads_.textures.push_back(texture_handle);
         delete texture;
 
         return true;
@@ -489,6 +1233,11 @@ public:
     }
 
     bool create_texture(Rml::TextureHandle texture_handle, const Rml::byte* source, const Rml::Vector2i& source_dimensions, bool flip_y = false, bool bgra = false) {
+        // Textures #0 and #1 stay standalone, since the placeholder has to be drawable before the first atlas copy.
+        if (texture_handle > 1 && !bgra && fits_in_atlas(source_dimensions)) {
+            return create_atlas_texture(texture_handle, source, source_dimensions, flip_y);
+        }
+
         std::unique_ptr<RT64::RenderTexture> texture =
             device_->createTexture(RT64::RenderTextureDesc::Texture2D(source_dimensions.x, source_dimensions.y, 1, bgra ? RmlTextureFormatBgra : RmlTextureFormat));
 
@@ -504,14 +1253,11 @@ public:
             // Calculate the real number of bytes to upload including padding.
             uint32_t uploaded_size_bytes = row_byte_width * source_dimensions.y;
 
-            // Allocate room in the upload buffer for the uploaded data.
-            if (uploaded_size_bytes > copy_buffer_size_) {
-                copy_buffer_size_ = (uploaded_size_bytes * 3) / 2;
-                copy_buffer_ = device_->createBuffer(RT64::RenderBufferDesc::UploadBuffer(copy_buffer_size_));
-            }
+            // Create a staging buffer for the uploaded data. It's kept alive until the batch it's in has finished copying.
+            std::unique_ptr<RT64::RenderBuffer> staging_buffer = device_->createBuffer(RT64::RenderBufferDesc::UploadBuffer(uploaded_size_bytes));
 
-            // Copy the source data into the upload buffer.
-            uint8_t* dst_data = (uint8_t *)(copy_buffer_->map());
+            // Copy the source data into the staging buffer.
+            uint8_t* dst_data = (uint8_t *)(staging_buffer->map());
             if (row_byte_padding == 0) {
                 // Copy row-by-row if the image is flipped.
                 if (flip_y) {
@@ -536,30 +1282,28 @@ public:
                 }
             }
 
-            copy_buffer_->unmap();
+            staging_buffer->unmap();
 
-            // Reset the command list.
-            copy_command_list_->begin();
+            // Add the copy to this frame's upload batch.
+            RT64::RenderCommandList *upload_list = begin_upload();
 
             // Prepare the texture to be a destination for copying.
-            copy_command_list_->barriers(RT64::RenderBarrierStage::COPY, RT64::RenderTextureBarrier(texture.get(), RT64::RenderTextureLayout::COPY_DEST));
+            upload_list->barriers(RT64::RenderBarrierStage::COPY, RT64::RenderTextureBarrier(texture.get(), RT64::RenderTextureLayout::COPY_DEST));
             
-            // Copy the upload buffer into the texture.
-            copy_command_list_->copyTextureRegion(
+            // Copy the staging buffer into the texture.
+            upload_list->copyTextureRegion(
                 RT64::RenderTextureCopyLocation::Subresource(texture.get()),
-                RT64::RenderTextureCopyLocation::PlacedFootprint(copy_buffer_.get(), RmlTextureFormat, source_dimensions.x, source_dimensions.y, 1, row_width));
-            
-            // End the command list, execute it and wait.
-            copy_command_list_->end();
-            copy_command_queue_->executeCommandLists(copy_command_list_.get(), copy_command_fence_.get());
-            copy_command_queue_->waitForCommandFence(copy_command_fence_.get());
+                RT64::RenderTextureCopyLocation::PlacedFootprint(staging_buffer.get(), RmlTextureFormat, source_dimensions.x, source_dimensions.y, 1, row_width));
+
+            recording_uploads_.staging_buffers.emplace_back(std::move(staging_buffer));
+            recording_uploads_.textures.push_back(texture_handle);
 
             // Create a descriptor set with this texture in it.
             std::unique_ptr<RT64::RenderDescriptorSet> set = texture_set_builder_->create(device_);
 
             set->setTexture(gTexture_descriptor_index, texture.get(), RT64::RenderTextureLayout::SHADER_READ);
 
-            textures_.emplace(texture_handle, TextureHandle{ std::move(texture), std::move(set), false });
+            textures_.emplace(texture_handle, TextureHandle{ std::move(texture), std::move(set), false, false });
 
             return true;
         }
@@ -570,12 +1314,38 @@ public:
 	void ReleaseTexture(Rml::TextureHandle texture) override {
         if (texture > 1) {
             // Textures #0 and #1 are reserved and should never be released.
-            textures_.erase(texture);
+            auto it = textures_.find(texture);
+            if (it == textures_.end()) {
+                return;
+            }
+
+            // Draw any batched geometry that uses this texture while it still exists.
+            if (list_ != nullptr && batch_.num_indices > 0 && batch_.texture_set == get_texture_set(it->second, atlas_pages_)) {
+                flush_batch();
+            }
+
+            if (it->second.atlas_page >= 0) {
+                // Drop the copy if it hasn't been recorded yet, since the space may be handed out again.
+                std::erase_if(atlas_uploads_, [texture](const AtlasUpload &upload) { return upload.texture == texture; });
+                atlas_pages_[it->second.atlas_page].release(it->second.atlas_x, it->second.atlas_y, it->second.atlas_width);
+            }
+            else if (!it->second.uploaded) {
+                // The copy into this texture may still be pending, so keep it alive until its batch finishes.
+                UploadBatch &batch = recording_uploads_.contains(texture) ? recording_uploads_ : submitted_uploads_;
+                batch.released_textures.emplace_back(std::move(it->second));
+            }
+
+            textures_.erase(it);
         }
     }
 
     void SetTransform(const Rml::Matrix4f* transform) override {
+        // The transform is a push constant, so anything batched so far has to be drawn with the old one.
+        if (list_ != nullptr) {
+            flush_batch();
+        }
         transform_ = transform ? *transform : Rml::Matrix4f::Identity();
+        hash_frame_value(transform_);
         recalculate_mvp();
     }
 
@@ -583,19 +1353,38 @@ public:
         mvp_ = projection_mtx_ * transform_;
     }
 
-    void start(RT64::RenderCommandList* list, int image_width, int image_height) {
+    void start(RT64::RenderCommandList* list, int image_width, int image_height, bool cache_frame) {
         list_ = list;
 
-        if (multisampling_.sampleCount > 1) {
-            if (window_width_ != image_width || window_height_ != image_height) {
-                screen_framebuffer_.reset();
-                screen_texture_ = device_->createTexture(RT64::RenderTextureDesc::ColorTarget(image_width, image_height, SwapChainFormat));
+        // Textures uploaded last frame become visible from this frame on.
+        finish_uploads();
+        bound_texture_set_ = nullptr;
+        frame_hash_ = frame_hash_seed;
+        frame_used_placeholder_ = false;
+        cached_frame_valid_ = false;
+
+        // MSAA always renders into the internal textures, so every such frame can be reused. Otherwise the UI is only
+        // rendered into them when the frame is going to be cached, and straight to the swap chain the rest of the time.
+        render_to_texture_ = cache_frame || multisampling_.sampleCount > 1;
+
+        if (window_width_ != image_width || window_height_ != image_height) {
+            screen_framebuffer_.reset();
+            screen_texture_.reset();
+            screen_texture_ms_.reset();
+        }
+
+        if (render_to_texture_ && screen_texture_ == nullptr) {
+            screen_texture_ = device_->createTexture(RT64::RenderTextureDesc::ColorTarget(image_width, image_height, SwapChainFormat));
+            const RT64::RenderTexture *color_attachment = screen_texture_.get();
+            if (multisampling_.sampleCount > 1) {
                 screen_texture_ms_ = device_->createTexture(RT64::RenderTextureDesc::ColorTarget(image_width, image_height, SwapChainFormat, multisampling_));
-                const RT64::RenderTexture *color_attachment = screen_texture_ms_.get();
-                screen_framebuffer_ = device_->createFramebuffer(RT64::RenderFramebufferDesc(&color_attachment, 1));
-                screen_descriptor_set_->setTexture(0, screen_texture_.get(), RT64::RenderTextureLayout::SHADER_READ);
+                color_attachment = screen_texture_ms_.get();
             }
+            screen_framebuffer_ = device_->createFramebuffer(RT64::RenderFramebufferDesc(&color_attachment, 1));
+            screen_descriptor_set_->setTexture(0, screen_texture_.get(), RT64::RenderTextureLayout::SHADER_READ);
+        }
 
+        if (multisampling_.sampleCount > 1) {
             list_->setPipeline(pipeline_ms_.get());
         }
         else {
@@ -621,65 +1410,128 @@ public:
         reset_dynamic_buffer(vertex_buffer_);
         reset_dynamic_buffer(index_buffer_);
 
-        // Set an internal texture as the render target if MSAA is enabled.
-        if (multisampling_.sampleCount > 1) {
-            list->barriers(RT64::RenderBarrierStage::GRAPHICS, RT64::RenderTextureBarrier(screen_texture_ms_.get(), RT64::RenderTextureLayout::COLOR_WRITE));
+        // Record the copies into atlas pages and compiled geometry buffers before anything is drawn from them.
+        flush_atlas_uploads();
+        flush_geometry_uploads();
+
+        // Render into the internal texture, which is the multisampled one if MSAA is enabled.
+        if (render_to_texture_) {
+            RT64::RenderTexture *render_target = multisampling_.sampleCount > 1 ? screen_texture_ms_.get() : screen_texture_.get();
+            list->barriers(RT64::RenderBarrierStage::GRAPHICS, RT64::RenderTextureBarrier(render_target, RT64::RenderTextureLayout::COLOR_WRITE));
             list->setFramebuffer(screen_framebuffer_.get());
             list->clearColor(0, RT64::RenderColor(0.0f, 0.0f, 0.0f, 0.0f));
         }
     }
 
     void end(RT64::RenderCommandList* list, RT64::RenderFramebuffer* framebuffer) {
-        // Draw the texture were rendered the UI in to the swap chain framebuffer if MSAA is enabled.
-        if (multisampling_.sampleCount > 1) {
-            RT64::RenderTextureBarrier before_resolve_barriers[] = {
-                RT64::RenderTextureBarrier(screen_texture_ms_.get(), RT64::RenderTextureLayout::RESOLVE_SOURCE),
-                RT64::RenderTextureBarrier(screen_texture_.get(), RT64::RenderTextureLayout::RESOLVE_DEST)
-            };
+        flush_batch();
+
+        // Resolve the multisampled texture if MSAA is enabled, then draw the texture the UI was rendered in to the swap chain framebuffer.
+        if (render_to_texture_) {
+            if (multisampling_.sampleCount > 1) {
+                RT64::RenderTextureBarrier before_resolve_barriers[] = {
+                    RT64::RenderTextureBarrier(screen_texture_ms_.get(), RT64::RenderTextureLayout::RESOLVE_SOURCE),
+                    RT64::RenderTextureBarrier(screen_texture_.get(), RT64::RenderTextureLayout::RESOLVE_DEST)
+                };
+
+                list->barriers(RT64::RenderBarrierStage::COPY, before_resolve_barriers, uint32_t(std::size(before_resolve_barriers)));
+                list->resolveTexture(screen_texture_.get(), screen_texture_ms_.get());
+            }
 
-            list->barriers(RT64::RenderBarrierStage::COPY, before_resolve_barriers, uint32_t(std::size(before_resolve_barriers)));
-            list->resolveTexture(screen_texture_.get(), screen_texture_ms_.get());
             list->barriers(RT64::RenderBarrierStage::GRAPHICS, RT64::RenderTextureBarrier(screen_texture_.get(), RT64::RenderTextureLayout::SHADER_READ));
-            list->setFramebuffer(framebuffer);
-            list->setPipeline(pipeline_.get());
-            list->setGraphicsPipelineLayout(layout_.get());
-            list->setGraphicsDescriptorSet(sampler_set_.get(), 0);
-            list->setGraphicsDescriptorSet(screen_descriptor_set_.get(), 1);
-            list->setScissors(RT64::RenderRect{ 0, 0, window_width_, window_height_ });
-            RT64::RenderVertexBufferView vertex_view(screen_vertex_buffer_.get(), screen_vertex_buffer_size_);
-            list->setVertexBuffers(0, &vertex_view, 1, &vertex_slot_);
-
-            RmlPushConstants constants{
-                .transform = Rml::Matrix4f::Identity(),
-                .translation = Rml::Vector2f(0.0f, 0.0f)
-            };
-
-            list_->setGraphicsPushConstants(0, &constants);
-            list->drawInstanced(3, 1, 0, 0);
+            cached_frame_valid_ = true;
+            cached_frame_hash_ = frame_hash_;
+            draw_screen_texture(list, framebuffer);
         }
 
         end_dynamic_buffer(upload_buffer_);
         end_dynamic_buffer(vertex_buffer_);
         end_dynamic_buffer(index_buffer_);
 
+        // Kick off every texture upload requested this frame in one submission.
+        submit_uploads();
+
         list_ = nullptr;
     }
 
+    // Draws the last rendered frame to the framebuffer.
+    void draw_screen_texture(RT64::RenderCommandList* list, RT64::RenderFramebuffer* framebuffer) {
+        list->setFramebuffer(framebuffer);
+        list->setPipeline(pipeline_.get());
+        list->setGraphicsPipelineLayout(layout_.get());
+        list->setGraphicsDescriptorSet(sampler_set_.get(), 0);
+        list->setGraphicsDescriptorSet(screen_descriptor_set_.get(), 1);
+        list->setViewports(RT64::RenderViewport{ 0, 0, float(window_width_), float(window_height_) });
+        list->setScissors(RT64::RenderRect{ 0, 0, window_width_, window_height_ });
+        RT64::RenderVertexBufferView vertex_view(screen_vertex_buffer_.get(), screen_vertex_buffer_size_);
+        list->setVertexBuffers(0, &vertex_view, 1, &vertex_slot_);
+
+        RmlPushConstants constants{
+            .transform = Rml::Matrix4f::Identity(),
+            .translation = Rml::Vector2f(0.0f, 0.0f)
+        };
+
+        list->setGraphicsPushConstants(0, &constants);
+        list->drawInstanced(3, 1, 0, 0);
+    }
+
+    bool has_cached_frame(int image_width, int image_height) const {
+        return cached_frame_valid_ && window_width_ == image_width && window_height_ == image_height;
+    }
+
+    // Draws the previous frame again without re-rendering any of its geometry.
+    void draw_cached_frame(RT64::RenderCommandList* list, RT64::RenderFramebuffer* framebuffer) {
+        assert(cached_frame_valid_ && "Drew a cached frame before one was rendered!");
+        draw_screen_texture(list, framebuffer);
+    }
+
+    uint64_t get_frame_hash() const {
+        return frame_hash_;
+    }
+
+    // Starts hashing what Rml renders without drawing any of it, to check whether the cached frame is still current.
+    void begin_frame_check() {
+        assert(list_ == nullptr && "Started a frame check during a frame!");
+        frame_hash_ = frame_hash_seed;
+        hash_only_ = true;
+    }
+
+    // Returns whether what was rendered since begin_frame_check matches the cached frame.
+    bool end_frame_check() {
+        hash_only_ = false;
+        return cached_frame_valid_ && frame_hash_ == cached_frame_hash_;
+    }
+
+    // Whether the last frame was drawn with content that has since finished uploading, so a new frame would look different.
+    bool needs_redraw() const {
+        return frame_used_placeholder_ || !submitted_uploads_.textures.empty() || !atlas_uploads_.empty() || !geometry_uploads_.empty();
+    }
+
     void queue_image_from_bytes_file(const std::string &src, const std::vector<char> &bytes) {
         // Width and height aren't used for file images, so set them to 0.
-        image_from_bytes_queue.enqueue(ImageFromBytes{ .type = ImageType::File, .width = 0, .height = 0, .name = src, .bytes = bytes });
+        auto job = std::make_shared<ImageDecodeJob>();
+        job->image = ImageFromBytes{ .type = ImageType::File, .width = 0, .height = 0, .name = src, .bytes = std::vector<uint8_t>(bytes.begin(), bytes.end()) };
+
+        // Start decoding right away so the image is ready by the time the UI wants to draw it.
+        image_from_bytes_queue.enqueue(job);
+        decode_queue_.enqueue(job);
+        decode_signal_.signal();
     }
 
     void queue_image_from_bytes_rgba32(const std::string &src, const std::vector<char> &bytes, uint32_t width, uint32_t height) {
-        image_from_bytes_queue.enqueue(ImageFromBytes{ .type = ImageType::RGBA32, .width = width, .height = height, .name = src, .bytes = bytes });
+        // Already decoded.
+        auto job = std::make_shared<ImageDecodeJob>();
+        job->image = ImageFromBytes{ .type = ImageType::RGBA32, .width = width, .height = height, .name = src, .bytes = std::vector<uint8_t>(bytes.begin(), bytes.end()) };
+        job->claimed = true;
+        job->decoded = true;
+        image_from_bytes_queue.enqueue(job);
     }
 
     void flush_image_from_bytes_queue() {
-        ImageFromBytes image_from_bytes;
-        while (image_from_bytes_queue.try_dequeue(image_from_bytes)) {
-            // We can move the name into the map since the name in the actual entry is no longer needed.
-            // After that, move the entry itself into the map.
-            image_from_bytes_map.emplace(std::move(image_from_bytes.name), std::move(image_from_bytes));
+        std::shared_ptr<ImageDecodeJob> job;
+        while (image_from_bytes_queue.try_dequeue(job)) {
+            const std::string &name = job->image.name;
+            image_from_bytes_map.emplace(name, std::move(job));
         }
     }
 };
@@ -703,10 +1555,10 @@ Rml::RenderInterface* recompui::RmlRenderInterface_RT64::get_rml_interface() {
     return nullptr;
 }
 
-void recompui::RmlRenderInterface_RT64::start(RT64::RenderCommandList* list, int image_width, int image_height) {
+void recompui::RmlRenderInterface_RT64::start(RT64::RenderCommandList* list, int image_width, int image_height, bool cache_frame) {
     assert(static_cast<bool>(impl));
 
-    impl->start(list, image_width, image_height);
+    impl->start(list, image_width, image_height, cache_frame);
 }
 
 void recompui::RmlRenderInterface_RT64::end(RT64::RenderCommandList* list, RT64::RenderFramebuffer* framebuffer) {
@@ -715,6 +1567,42 @@ void recompui::RmlRenderInterface_RT64::end(RT64::RenderCommandList* list, RT64:
     impl->end(list, framebuffer);
 }
 
+bool recompui::RmlRenderInterface_RT64::has_cached_frame(int image_width, int image_height) {
+    assert(static_cast<bool>(impl));
+
+    return impl->has_cached_frame(image_width, image_height);
+}
+
+void recompui::RmlRenderInterface_RT64::draw_cached_frame(RT64::RenderCommandList* list, RT64::RenderFramebuffer* framebuffer) {
+    assert(static_cast<bool>(impl));
+
+    impl->draw_cached_frame(list, framebuffer);
+}
+
+uint64_t recompui::RmlRenderInterface_RT64::get_frame_hash() {
+    assert(static_cast<bool>(impl));
+
+    return impl->get_frame_hash();
+}
+
+void recompui::RmlRenderInterface_RT64::begin_frame_check() {
+    assert(static_cast<bool>(impl));
+
+    impl->begin_frame_check();
+}
+
+bool recompui::RmlRenderInterface_RT64::end_frame_check() {
+    assert(static_cast<bool>(impl));
+
+    return impl->end_frame_check();
+}
+
+bool recompui::RmlRenderInterface_RT64::needs_redraw() {
+    assert(static_cast<bool>(impl));
+
+    return impl->needs_redraw();
+}
+
 void recompui::RmlRenderInterface_RT64::queue_image_from_bytes_file(const std::string &src, const std::vector<char> &bytes) {
     assert(static_cast<bool>(impl));
 
@@ -28,8 +28,21 @@ namespace recompui {
         void init(RT64::RenderInterface* interface, RT64::RenderDevice* device);
         Rml::RenderInterface* get_rml_interface();
         
-        void start(RT64::RenderCommandList* list, int image_width, int image_height);
+        // Frames are rendered straight to the swap chain unless cache_frame is set, in which case they're kept so that
+        // they can be drawn again with draw_cached_frame.
+        void start(RT64::RenderCommandList* list, int image_width, int image_height, bool cache_frame);
         void end(RT64::RenderCommandList* list, RT64::RenderFramebuffer* framebuffer);
+        // Whether the last rendered frame is still available at this size and can be drawn again with draw_cached_frame.
+        bool has_cached_frame(int image_width, int image_height);
+        void draw_cached_frame(RT64::RenderCommandList* list, RT64::RenderFramebuffer* framebuffer);
+        // Hash of the geometry, textures and state drawn between the last start and end.
+        uint64_t get_frame_hash();
+        // Rml::Context::Render calls between these only hash the frame instead of drawing it. end_frame_check returns
+        // whether that frame matches the cached one, in which case the cached frame can be drawn again instead.
+        void begin_frame_check();
+        bool end_frame_check();
+        // Whether content drawn last frame has changed since, such as a texture that finished uploading.
+        bool needs_redraw();
         void queue_image_from_bytes_file(const std::string &src, const std::vector<char> &bytes);
         void queue_image_from_bytes_rgba32(const std::string &src, const std::vector<char> &bytes, uint32_t width, uint32_t height);
     };
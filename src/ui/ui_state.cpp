@@ -5,9 +5,14 @@
 #else
 #include <SDL2/SDL_video.h>
 #endif
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #include "rt64_render_hooks.h"
 
@@ -193,6 +198,8 @@ public:
     bool await_stick_return_x = false;
     bool await_stick_return_y = false;
     int last_active_mouse_position[2] = {0, 0};
+    // Set when a context is shown or hidden, cleared once the UI has been rendered with the change.
+    bool shown_contexts_changed = false;
     std::unique_ptr<recompui::MenuController> config_controller;
     std::unique_ptr<recompui::MenuController> launcher_controller;
     std::unique_ptr<SystemInterface_SDL> system_interface;
@@ -369,6 +376,7 @@ public:
             assert(false);
         }
         Rml::ElementDocument* document = context.get_document();
+        shown_contexts_changed = true;
         shown_contexts.push_back(ContextDetails{
             .context = context,
             .document = document
@@ -396,6 +404,7 @@ public:
             assert(false);
         }
         shown_contexts.erase(remove_it, shown_contexts.end());
+        shown_contexts_changed = true;
 
         context.get_document()->Hide();
     }
@@ -406,6 +415,7 @@ public:
         }
 
         shown_contexts.clear();
+        shown_contexts_changed = true;
     }
 
     bool is_context_shown(recompui::ContextId context) {
@@ -444,12 +454,15 @@ public:
         return nullptr;
     }
 
-    void update_contexts() {
+    // Returns whether any of the shown contexts had queued updates or were modified since the last update.
+    bool update_contexts() {
+        bool had_updates = false;
         for (auto& context_details : shown_contexts) {
             context_details.context.open();
-            context_details.context.process_updates();
-            context_details.context.close();
+            had_updates |= context_details.context.process_updates();
+            context_details.context.close_unmodified();
         }
+        return had_updates;
     }
 };
 
@@ -569,6 +582,9 @@ void recompui::activate_mouse() {
     ui_state->update_focus(true, false);
 }
 
+static void process_finished_mod_installations();
+static void stop_mod_installation();
+
 void draw_hook(RT64::RenderCommandList* command_list, RT64::RenderFramebuffer* swap_chain_framebuffer) {
 
     apply_background_input_mode();
@@ -585,6 +601,8 @@ void draw_hook(RT64::RenderCommandList* command_list, RT64::RenderFramebuffer* s
 
     std::lock_guard lock{ ui_state_mutex };
 
+    process_finished_mod_installations();
+
     SDL_Event cur_event{};
 
     bool mouse_moved = false;
@@ -603,7 +621,14 @@ void draw_hook(RT64::RenderCommandList* command_list, RT64::RenderFramebuffer* s
     static clock::time_point next_repeat_time = {};
     static int latest_controller_key_pressed = SDLK_UNKNOWN;
 
+    // Once nothing has changed for this long, the last rendered frame is drawn again instead of rendering a new one.
+    constexpr clock::duration idle_delay = std::chrono::milliseconds{1000};
+    static clock::time_point last_activity_time = {};
+    static uint64_t last_frame_hash = 0;
+    bool had_events = false;
+
     while (recompui::try_deque_event(cur_event)) {
+        had_events = true;
         bool context_capturing_input = recompui::is_context_capturing_input();
         bool context_capturing_mouse = recompui::is_context_capturing_mouse();
 
@@ -758,6 +783,7 @@ void draw_hook(RT64::RenderCommandList* command_list, RT64::RenderFramebuffer* s
         if (now >= next_repeat_time) {
             ui_state->context->ProcessKeyDown(RmlSDL::ConvertKey(latest_controller_key_pressed), 0);
             next_repeat_time += repeat_rate;
+            had_events = true;
         }
     }
 
@@ -775,15 +801,40 @@ void draw_hook(RT64::RenderCommandList* command_list, RT64::RenderFramebuffer* s
     ui_state->update_focus(mouse_moved, non_mouse_interacted);
 
     if (recompui::is_any_context_shown()) {
-        ui_state->update_contexts();
+        bool had_updates = ui_state->update_contexts();
+        bool contexts_modified = ui_state->shown_contexts_changed;
+        ui_state->shown_contexts_changed = false;
 
         int width = swap_chain_framebuffer->getWidth();
         int height = swap_chain_framebuffer->getHeight();
 
+        clock::time_point now = clock::now();
+        if (had_events || had_updates || contexts_modified || ui_state->render_interface.needs_redraw() || Rml::Debugger::IsVisible()) {
+            last_activity_time = now;
+        }
+
         // Scale the UI based on the window size with 1080 vertical resolution as the reference point.
         ui_state->context->SetDensityIndependentPixelRatio((height) / 1080.0f);
 
-        ui_state->render_interface.start(command_list, width, height);
+        // Once nothing has changed for a while, the last frame is drawn again instead of rendering a new one. The
+        // context is still updated and its output hashed every frame, so animations and data model changes that don't
+        // come with any events resume rendering right away.
+        bool idle = now - last_activity_time >= idle_delay;
+        if (idle && ui_state->render_interface.has_cached_frame(width, height)) {
+            ui_state->context->Update();
+            ui_state->render_interface.begin_frame_check();
+            ui_state->context->Render();
+            if (ui_state->render_interface.end_frame_check()) {
+                ui_state->render_interface.draw_cached_frame(command_list, swap_chain_framebuffer);
+                return;
+            }
+
+            last_activity_time = now;
+            idle = false;
+        }
+
+        // Only the first idle frame is rendered into the cache, so frames that change don't pay for compositing it.
+        ui_state->render_interface.start(command_list, width, height, idle);
 
         static int prev_width = 0;
         static int prev_height = 0;
@@ -797,10 +848,18 @@ void draw_hook(RT64::RenderCommandList* command_list, RT64::RenderFramebuffer* s
         ui_state->context->Update();
         ui_state->context->Render();
         ui_state->render_interface.end(command_list, swap_chain_framebuffer);
+
+        // Don't go idle while the frame keeps looking different from the last one, e.g. because an animation is playing.
+        uint64_t frame_hash = ui_state->render_interface.get_frame_hash();
+        if (frame_hash != last_frame_hash) {
+            last_activity_time = now;
+        }
+        last_frame_hash = frame_hash;
     }
 }
 
 void deinit_hook() {
+    stop_mod_installation();
     recompui::destroy_all_contexts();
 
     std::lock_guard lock {ui_state_mutex};
@@ -922,20 +981,21 @@ void recompui::release_image(const std::string &src) {
     Rml::ReleaseTexture(src);
 }
 
-void recompui::drop_files(const std::list<std::filesystem::path> &file_list) {
-    // Prevent mod installation after the game has started.
-    if (ultramodern::is_game_started()) {
-        return;
-    }
-
-    recompui::open_notification("Installing Mods", "Please Wait");
-    // TODO: Needs a progress callback and a prompt for every mod that needs to be confirmed to be overwritten.
-    // TODO: Run this on a background thread and use the callbacks to advance the state instead of blocking.
-    ModInstaller::Result result;
-    ModInstaller::start_mod_installation(file_list, nullptr, result);
-
-    recompui::close_prompt();
-
+// Mods are installed on a separate thread so the UI keeps running while large archives are extracted.
+struct ModInstallState {
+    std::thread thread;
+    std::mutex mutex;
+    // Guarded by mutex.
+    bool running = false;
+    std::list<std::filesystem::path> queued_files;
+    // Installations that finished extracting, handed back to the UI thread to be confirmed or reported.
+    std::list<ModInstaller::Result> finished_results;
+    // Set when the UI is torn down so it doesn't have to wait for the installation to finish.
+    std::atomic_bool cancelled = false;
+} mod_install_state;
+
+static void process_mod_installation_result(const ModInstaller::Result &result) {
+    // TODO: Needs a prompt for every mod that needs to be confirmed to be overwritten.
     if (!result.error_messages.empty()) {
         std::string error_label = std::accumulate(result.error_messages.begin(), result.error_messages.end(), std::string{},
             [](const std::string &lhs, const std::string &rhs)
@@ -1038,3 +1098,117 @@ void recompui::drop_files(const std::list<std::filesystem::path> &file_list) {
         );
     }
 }
+
+void recompui::drop_files(const std::list<std::filesystem::path> &file_list) {
+    // Prevent mod installation after the game has started.
+    if (ultramodern::is_game_started()) {
+        return;
+    }
+
+    {
+        // Files dropped while an installation is running are installed along with it.
+        std::lock_guard lock{ mod_install_state.mutex };
+        if (mod_install_state.running) {
+            mod_install_state.queued_files.insert(mod_install_state.queued_files.end(), file_list.begin(), file_list.end());
+            return;
+        }
+
+        mod_install_state.running = true;
+    }
+
+    if (mod_install_state.thread.joinable()) {
+        mod_install_state.thread.join();
+    }
+
+    recompui::open_notification("Installing Mods", "Please Wait");
+
+    mod_install_state.thread = std::thread([file_list]() {
+        // Bytes processed and total bytes of each file that has started installing. Only accessed from the
+        // progress callback, which is never called concurrently.
+        std::unordered_map<std::u8string, std::pair<size_t, size_t>> file_progress;
+        int last_percent = 0;
+        auto progress_callback = [&](std::filesystem::path path, size_t processed_bytes, size_t total_bytes) {
+            file_progress[path.u8string()] = { processed_bytes, total_bytes };
+
+            size_t all_processed_bytes = 0;
+            size_t all_total_bytes = 0;
+            for (const auto &[file_path, progress] : file_progress) {
+                all_processed_bytes += progress.first;
+                all_total_bytes += progress.second;
+            }
+
+            int percent = all_total_bytes > 0 ? int(uint64_t(all_processed_bytes) * 100 / all_total_bytes) : 0;
+            if (percent != last_percent) {
+                last_percent = percent;
+                recompui::open_notification("Installing Mods", "Please Wait (" + std::to_string(percent) + "%)");
+            }
+        };
+
+        ModInstaller::Result result;
+        std::list<std::filesystem::path> cur_files = file_list;
+        while (true) {
+            ModInstaller::Result cur_result;
+            ModInstaller::start_mod_installation(cur_files, progress_callback, cur_result, &mod_install_state.cancelled);
+            result.error_messages.splice(result.error_messages.end(), cur_result.error_messages);
+            result.pending_installations.splice(result.pending_installations.end(), cur_result.pending_installations);
+
+            std::lock_guard lock{ mod_install_state.mutex };
+            if (mod_install_state.queued_files.empty() || mod_install_state.cancelled) {
+                mod_install_state.running = false;
+                break;
+            }
+
+            cur_files = std::move(mod_install_state.queued_files);
+            mod_install_state.queued_files.clear();
+        }
+
+        // The UI may already be gone if the installation was cancelled because the app is closing.
+        if (mod_install_state.cancelled) {
+            std::vector<std::string> dummy_error_messages{};
+            ModInstaller::cancel_mod_installation(result, dummy_error_messages);
+            return;
+        }
+
+        std::lock_guard lock{ mod_install_state.mutex };
+        mod_install_state.finished_results.emplace_back(std::move(result));
+    });
+}
+
+// Runs on the UI thread, so that the prompts and mod list aren't modified while the UI is using them.
+static void process_finished_mod_installations() {
+    std::list<ModInstaller::Result> results;
+    {
+        std::lock_guard lock{ mod_install_state.mutex };
+        if (mod_install_state.finished_results.empty()) {
+            return;
+        }
+        results.swap(mod_install_state.finished_results);
+    }
+
+    for (const ModInstaller::Result &result : results) {
+        recompui::close_prompt();
+
+        // The mods can't be swapped out anymore if the game was started while they were being extracted.
+        if (ultramodern::is_game_started()) {
+            std::vector<std::string> dummy_error_messages{};
+            ModInstaller::cancel_mod_installation(result, dummy_error_messages);
+        }
+        else {
+            process_mod_installation_result(result);
+        }
+    }
+}
+
+// Cancels any running installation and waits for its thread. Must be called before the UI is torn down.
+static void stop_mod_installation() {
+    mod_install_state.cancelled = true;
+    if (mod_install_state.thread.joinable()) {
+        mod_install_state.thread.join();
+    }
+
+    std::vector<std::string> dummy_error_messages{};
+    for (const ModInstaller::Result &result : mod_install_state.finished_results) {
+        ModInstaller::cancel_mod_installation(result, dummy_error_messages);
+    }
+    mod_install_state.finished_results.clear();
+}
@@ -0,0 +1,250 @@
+#include "ui_thumbnail_cache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "config/config.hpp"
+
+#include "../../lib/rt64/src/contrib/stb/stb_image.h"
+
+namespace recompui {
+    // Cache files are a fixed header, the mod path and then the raw RGBA32 pixels at an aligned offset, so a file
+    // can be read (or mapped) and handed to the uploader without any parsing.
+    static constexpr uint32_t thumbnail_cache_magic = 0x4D555448; // "HTUM"
+    static constexpr uint32_t thumbnail_cache_version = 1;
+    static constexpr uint32_t thumbnail_pixels_alignment = 16;
+    // Thumbnails are never shown larger than 100dp, so this leaves room for high DPI displays.
+    static constexpr uint32_t max_thumbnail_size = 256;
+
+    struct ThumbnailCacheHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t file_size;
+        int64_t write_time;
+        uint32_t width;
+        uint32_t height;
+        uint32_t path_length;
+        uint32_t pixels_offset;
+    };
+
+    static std::filesystem::path get_thumbnail_cache_directory() {
+        return dino::config::get_app_folder_path() / "cache" / "thumbnails";
+    }
+
+    static std::filesystem::path get_thumbnail_cache_path(const ThumbnailCacheKey &key) {
+        // Hash collisions are caught by comparing the mod path stored in the file.
+        size_t path_hash = std::hash<std::u8string>{}(key.mod_path.u8string());
+        char filename[32];
+        snprintf(filename, sizeof(filename), "%016llx.bin", (unsigned long long)(path_hash));
+        return get_thumbnail_cache_directory() / filename;
+    }
+
+    bool get_thumbnail_cache_key(const std::filesystem::path &mod_path, ThumbnailCacheKey &key_out) {
+        std::error_code ec;
+        std::filesystem::path absolute_path = std::filesystem::absolute(mod_path, ec);
+        if (ec) {
+            return false;
+        }
+
+        // Mods can also be folders, whose contents can change without the folder's size or time changing.
+        if (!std::filesystem::is_regular_file(absolute_path, ec)) {
+            return false;
+        }
+
+        uint64_t file_size = std::filesystem::file_size(absolute_path, ec);
+        if (ec) {
+            return false;
+        }
+
+        std::filesystem::file_time_type write_time = std::filesystem::last_write_time(absolute_path, ec);
+        if (ec) {
+            return false;
+        }
+
+        key_out.mod_path = std::move(absolute_path);
+        key_out.file_size = file_size;
+        key_out.write_time = int64_t(write_time.time_since_epoch().count());
+        return true;
+    }
+
+    static bool read_thumbnail_cache_file(const ThumbnailCacheKey &key, CachedThumbnail &thumbnail_out) {
+        std::ifstream input_file{ get_thumbnail_cache_path(key), std::ios::binary };
+        if (!input_file.good()) {
+            return false;
+        }
+
+        ThumbnailCacheHeader header;
+        if (!input_file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+            return false;
+        }
+
+        if (header.magic != thumbnail_cache_magic || header.version != thumbnail_cache_version ||
+            header.file_size != key.file_size || header.write_time != key.write_time)
+        {
+            return false;
+        }
+
+        // The header can't be trusted until the mod path matches, so check the length before allocating for it.
+        std::u8string mod_path = key.mod_path.u8string();
+        if (header.path_length != mod_path.size()) {
+            return false;
+        }
+
+        std::u8string cached_path(header.path_length, u8'\0');
+        if (!input_file.read(reinterpret_cast<char *>(cached_path.data()), cached_path.size()) || cached_path != mod_path) {
+            return false;
+        }
+
+        // Thumbnails without pixels have a size of 0x0, anything else must be within the size they're written at.
+        bool has_pixels = header.width != 0 || header.height != 0;
+        if (has_pixels && (header.width == 0 || header.height == 0 || header.width > max_thumbnail_size || header.height > max_thumbnail_size)) {
+            return false;
+        }
+
+        size_t pixels_size = size_t(header.width) * size_t(header.height) * 4;
+        std::error_code ec;
+        uint64_t cache_file_size = std::filesystem::file_size(get_thumbnail_cache_path(key), ec);
+        if (ec || uint64_t(header.pixels_offset) + pixels_size > cache_file_size) {
+            return false;
+        }
+
+        // Read the pixels directly into the buffer that gets queued for upload.
+        thumbnail_out.width = header.width;
+        thumbnail_out.height = header.height;
+        thumbnail_out.pixels.resize(pixels_size);
+        if (pixels_size > 0) {
+            input_file.seekg(header.pixels_offset);
+            if (!input_file.read(thumbnail_out.pixels.data(), pixels_size)) {
+                thumbnail_out = {};
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static void write_thumbnail_cache_file(const ThumbnailCacheKey &key, const CachedThumbnail &thumbnail) {
+        std::error_code ec;
+        std::filesystem::create_directories(get_thumbnail_cache_directory(), ec);
+        if (ec) {
+            return;
+        }
+
+        std::u8string mod_path = key.mod_path.u8string();
+        uint32_t header_and_path_size = uint32_t(sizeof(ThumbnailCacheHeader) + mod_path.size());
+        ThumbnailCacheHeader header{
+            .magic = thumbnail_cache_magic,
+            .version = thumbnail_cache_version,
+            .file_size = key.file_size,
+            .write_time = key.write_time,
+            .width = thumbnail.width,
+            .height = thumbnail.height,
+            .path_length = uint32_t(mod_path.size()),
+            .pixels_offset = (header_and_path_size + thumbnail_pixels_alignment - 1) & ~(thumbnail_pixels_alignment - 1),
+        };
+
+        // Write to a temporary file first so a partially written file is never picked up.
+        std::filesystem::path cache_path = get_thumbnail_cache_path(key);
+        std::filesystem::path temp_path = cache_path;
+        temp_path += ".tmp";
+        {
+            std::ofstream output_file{ temp_path, std::ios::binary };
+            if (!output_file.good()) {
+                return;
+            }
+
+            const char padding[thumbnail_pixels_alignment] = {};
+            output_file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            output_file.write(reinterpret_cast<const char *>(mod_path.data()), mod_path.size());
+            output_file.write(padding, header.pixels_offset - header_and_path_size);
+            output_file.write(thumbnail.pixels.data(), thumbnail.pixels.size());
+            if (!output_file.good()) {
+                output_file.close();
+                std::filesystem::remove(temp_path, ec);
+                return;
+            }
+        }
+
+        std::filesystem::rename(temp_path, cache_path, ec);
+        if (ec) {
+            std::filesystem::remove(temp_path, ec);
+        }
+    }
+
+    // Box filters the image down so it fits within max_thumbnail_size, keeping its aspect ratio.
+    static void downscale_thumbnail(const stbi_uc *pixels, uint32_t width, uint32_t height, CachedThumbnail &thumbnail_out) {
+        uint32_t dst_width = width;
+        uint32_t dst_height = height;
+        if (width > max_thumbnail_size || height > max_thumbnail_size) {
+            if (width >= height) {
+                dst_width = max_thumbnail_size;
+                dst_height = std::max(uint32_t(uint64_t(height) * max_thumbnail_size / width), 1U);
+            }
+            else {
+                dst_height = max_thumbnail_size;
+                dst_width = std::max(uint32_t(uint64_t(width) * max_thumbnail_size / height), 1U);
+            }
+        }
+
+        thumbnail_out.width = dst_width;
+        thumbnail_out.height = dst_height;
+        thumbnail_out.pixels.resize(size_t(dst_width) * size_t(dst_height) * 4);
+        if (dst_width == width && dst_height == height) {
+            memcpy(thumbnail_out.pixels.data(), pixels, thumbnail_out.pixels.size());
+            return;
+        }
+
+        uint8_t *dst = reinterpret_cast<uint8_t *>(thumbnail_out.pixels.data());
+        for (uint32_t y = 0; y < dst_height; y++) {
+            uint32_t src_y_begin = uint32_t(uint64_t(y) * height / dst_height);
+            uint32_t src_y_end = std::max(uint32_t(uint64_t(y + 1) * height / dst_height), src_y_begin + 1);
+            for (uint32_t x = 0; x < dst_width; x++) {
+                uint32_t src_x_begin = uint32_t(uint64_t(x) * width / dst_width);
+                uint32_t src_x_end = std::max(uint32_t(uint64_t(x + 1) * width / dst_width), src_x_begin + 1);
+                uint32_t sums[4] = {};
+                for (uint32_t src_y = src_y_begin; src_y < src_y_end; src_y++) {
+                    const stbi_uc *src = pixels + (size_t(src_y) * width + src_x_begin) * 4;
+                    for (uint32_t src_x = src_x_begin; src_x < src_x_end; src_x++) {
+                        sums[0] += src[0];
+                        sums[1] += src[1];
+                        sums[2] += src[2];
+                        sums[3] += src[3];
+                        src += 4;
+                    }
+                }
+
+                uint32_t sample_count = (src_y_end - src_y_begin) * (src_x_end - src_x_begin);
+                for (uint32_t c = 0; c < 4; c++) {
+                    *dst++ = uint8_t(sums[c] / sample_count);
+                }
+            }
+        }
+    }
+
+    bool load_cached_thumbnail(const ThumbnailCacheKey &key, const std::function<const std::vector<char> &()> &read_thumbnail, CachedThumbnail &thumbnail_out) {
+        if (read_thumbnail_cache_file(key, thumbnail_out)) {
+            return true;
+        }
+
+        thumbnail_out = {};
+
+        // Mods without a thumbnail are cached too, so their archive doesn't need to be opened again either.
+        const std::vector<char> &bytes = read_thumbnail();
+        if (!bytes.empty()) {
+            int width, height, channels;
+            stbi_uc *pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc *>(bytes.data()), int(bytes.size()), &width, &height, &channels, 4);
+            if (pixels == nullptr) {
+                return false;
+            }
+
+            downscale_thumbnail(pixels, uint32_t(width), uint32_t(height), thumbnail_out);
+            stbi_image_free(pixels);
+        }
+
+        write_thumbnail_cache_file(key, thumbnail_out);
+        return true;
+    }
+}
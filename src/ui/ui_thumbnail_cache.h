@@ -0,0 +1,37 @@
+#ifndef RECOMPUI_THUMBNAIL_CACHE_H
+#define RECOMPUI_THUMBNAIL_CACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+namespace recompui {
+    // Identifies the version of a mod file that a thumbnail was taken from.
+    struct ThumbnailCacheKey {
+        std::filesystem::path mod_path;
+        uint64_t file_size = 0;
+        int64_t write_time = 0;
+
+        bool operator==(const ThumbnailCacheKey &rhs) const = default;
+    };
+
+    // Decoded RGBA32 thumbnail. Empty if the mod doesn't have a thumbnail or it couldn't be decoded.
+    struct CachedThumbnail {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<char> pixels;
+
+        bool empty() const { return pixels.empty(); }
+    };
+
+    // Returns false if the mod file can't be found, in which case its thumbnail can't be cached.
+    bool get_thumbnail_cache_key(const std::filesystem::path &mod_path, ThumbnailCacheKey &key_out);
+
+    // Loads the thumbnail for the mod file from the on-disk cache. If it isn't cached or the mod file changed since
+    // it was, the thumbnail is decoded from the bytes returned by read_thumbnail, downscaled and written to the cache.
+    // Returns false if the thumbnail had to be decoded but couldn't be, so the caller can fall back to the original bytes.
+    bool load_cached_thumbnail(const ThumbnailCacheKey &key, const std::function<const std::vector<char> &()> &read_thumbnail, CachedThumbnail &thumbnail_out);
+}
+
+#endif